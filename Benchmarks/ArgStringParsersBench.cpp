@@ -0,0 +1,166 @@
+#include <ArgStringParsers.h>
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+// Previous std::sto* based implementation, kept as a baseline.
+template<typename Type>
+std::enable_if_t<std::is_integral_v<Type>, Type>
+LegacyParseFromString(const std::string& value)
+{
+	try
+	{
+		if constexpr (std::is_unsigned<Type>::value)
+		{
+			const auto result = std::stoull(value);
+			if (result > std::numeric_limits<Type>::max())
+			{
+				throw ArgsParserException("Value out of range.");
+			}
+			return static_cast<Type>(result);
+		}
+		else
+		{
+			const auto result = std::stoll(value);
+			if (result > std::numeric_limits<Type>::max() || result < std::numeric_limits<Type>::min())
+			{
+				throw ArgsParserException("Value out of range.");
+			}
+			return static_cast<Type>(result);
+		}
+	}
+	catch (const std::invalid_argument& exc)
+	{
+		throw ArgsParserException(exc.what());
+	}
+	catch (const std::out_of_range& exc)
+	{
+		throw ArgsParserException(exc.what());
+	}
+}
+
+template<typename Type>
+std::enable_if_t<std::is_floating_point_v<Type>, Type>
+LegacyParseFromString(const std::string& value)
+{
+	try
+	{
+		const auto result = std::stold(value);
+		if (result > std::numeric_limits<Type>::max() || result < std::numeric_limits<Type>::min())
+		{
+			throw ArgsParserException("Value out of range.");
+		}
+		return static_cast<Type>(result);
+	}
+	catch (const std::invalid_argument& exc)
+	{
+		throw ArgsParserException(exc.what());
+	}
+	catch (const std::out_of_range& exc)
+	{
+		throw ArgsParserException(exc.what());
+	}
+}
+
+template<typename Type>
+std::vector<std::string> MakeValues()
+{
+	std::vector<std::string> values;
+	for (int i = 1; i <= 64; ++i)
+	{
+		if constexpr (std::is_floating_point_v<Type>)
+		{
+			// Legacy parser rejects values below numeric_limits::min(), so keep them positive.
+			values.push_back(std::to_string(i * 1.375));
+		}
+		else
+		{
+			values.push_back(std::to_string(static_cast<Type>(i * 7 % std::numeric_limits<int8_t>::max())));
+		}
+	}
+	return values;
+}
+
+template<typename Type>
+void BM_LegacyParseFromString(benchmark::State& state)
+{
+	const auto values = MakeValues<Type>();
+	for (auto _ : state)
+	{
+		for (const auto& value : values)
+		{
+			benchmark::DoNotOptimize(LegacyParseFromString<Type>(value));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+template<typename Type>
+void BM_ParseFromString(benchmark::State& state)
+{
+	const auto values = MakeValues<Type>();
+	for (auto _ : state)
+	{
+		for (const auto& value : values)
+		{
+			benchmark::DoNotOptimize(ParseFromString(value, ArgsParserHelpStruct<Type>()));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+#define SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(Type) \
+	BENCHMARK_TEMPLATE(BM_LegacyParseFromString, Type); \
+	BENCHMARK_TEMPLATE(BM_ParseFromString, Type)
+
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(int8_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(uint8_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(int16_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(uint16_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(int32_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(uint32_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(int64_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(uint64_t);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(float);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(double);
+SIMPLE_ARGS_PARSER_CONVERSION_BENCHMARK(long double);
+
+void BM_LegacyParseInvalidValue(benchmark::State& state)
+{
+	const std::string value = "abc";
+	for (auto _ : state)
+	{
+		try
+		{
+			benchmark::DoNotOptimize(LegacyParseFromString<int>(value));
+		}
+		catch (const ArgsParserException&)
+		{
+		}
+	}
+}
+BENCHMARK(BM_LegacyParseInvalidValue);
+
+void BM_ConvertInvalidValue(benchmark::State& state)
+{
+	const std::string value = "abc";
+	int result = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ConvertFromString(value, result));
+	}
+}
+BENCHMARK(BM_ConvertInvalidValue);
+
+} // namespace
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,51 @@
+#include <ArgsBatchParser.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+void BM_ParseArgsBatch(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	for (size_t i = 0; i < 50; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Help", ArgValue<int>().SetDefault(1));
+	}
+	args_initializer.Freeze();
+
+	std::vector<std::string> names;
+	for (size_t i = 0; i < 50; ++i)
+	{
+		names.push_back("--option" + std::to_string(i));
+	}
+
+	// Skewed lengths: every 16th command line sets all options.
+	std::vector<std::vector<const char*>> command_lines(10000, std::vector<const char*>{ "program" });
+	for (size_t i = 0; i < command_lines.size(); ++i)
+	{
+		const auto options_count = i % 16 == 0 ? names.size() : 2;
+		for (size_t j = 0; j < options_count; ++j)
+		{
+			command_lines[i].push_back(names[j].c_str());
+			command_lines[i].push_back("42");
+		}
+	}
+
+	for (auto _ : state)
+	{
+		auto results = ParseArgsBatch(command_lines, args_initializer, static_cast<size_t>(state.range(0)));
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(command_lines.size()));
+}
+BENCHMARK(BM_ParseArgsBatch)->Arg(1)->Arg(2)->Arg(4)->Arg(0)->UseRealTime();
+
+} // namespace
+
+} // namespace SimpleArgsParser
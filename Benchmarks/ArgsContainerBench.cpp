@@ -0,0 +1,117 @@
+#include "AllocationCounter.h"
+
+#include <ArgsParser.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+template<typename Type>
+Type GetDefaultValue()
+{
+	if constexpr (std::is_same_v<Type, std::string>)
+	{
+		return "default string value";
+	}
+	else
+	{
+		return static_cast<Type>(1);
+	}
+}
+
+template<typename Type>
+void BM_GetValue(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Help", ArgValue<Type>().SetDefault(GetDefaultValue<Type>()));
+	}
+	args_initializer.Freeze();
+	const char* argv[] = { "program" };
+	const auto args = ParseArgs(1, argv, args_initializer);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(args.GetValue<Type>("--option50"));
+	}
+}
+
+template<typename Type>
+void BM_GetValueByHandle(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	ArgHandle<Type> handle;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Help", ArgValue<Type>().SetDefault(GetDefaultValue<Type>()), handle);
+	}
+	args_initializer.Freeze();
+	const char* argv[] = { "program" };
+	const auto args = ParseArgs(1, argv, args_initializer);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(args[handle]);
+	}
+}
+
+#define SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(Type) \
+	BENCHMARK_TEMPLATE(BM_GetValue, Type); \
+	BENCHMARK_TEMPLATE(BM_GetValueByHandle, Type)
+
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(bool);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(int8_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(uint8_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(int16_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(uint16_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(int32_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(uint32_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(int64_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(uint64_t);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(float);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(double);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(long double);
+SIMPLE_ARGS_PARSER_GET_VALUE_BENCHMARK(std::string);
+
+// Heap bytes of a container parsed against 500 options with defaults, few of them set in argv.
+void BM_ParseArgsContainerMemory(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	for (size_t i = 0; i < 500; ++i)
+	{
+		const auto name = "option" + std::to_string(i);
+		if (i % 2 == 0)
+		{
+			args_initializer(name, "Help", ArgValue<int>().SetDefault(static_cast<int>(i)));
+		}
+		else
+		{
+			args_initializer(name, "Help", ArgValue<std::string>().SetDefault("default value which doesn't fit into small buffer"));
+		}
+	}
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "1", "--option1", "value" };
+
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		AllocationCounter counter;
+		const auto args = ParseArgs(5, argv, args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+		bytes = counter.GetBytes();
+	}
+	state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_ParseArgsContainerMemory);
+
+} // namespace
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,94 @@
+#include <ArgsListSplitter.h>
+#include <ArgsParser.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+std::string MakeIdsList(int64_t count)
+{
+	std::string result;
+	for (int64_t i = 0; i < count; ++i)
+	{
+		result += std::to_string(i * 7919 % 1000000);
+		result += ',';
+	}
+	if (!result.empty())
+	{
+		result.pop_back();
+	}
+	return result;
+}
+
+void BM_ParseListOption(benchmark::State& state)
+{
+	ArgHandle<std::vector<int>> ids;
+	ArgsInitializer args_initializer;
+	args_initializer("ids", "Ids", ArgValue<std::vector<int>>(), ids);
+	args_initializer.Freeze();
+
+	const auto list = MakeIdsList(state.range(0));
+	const char* argv[] = { "program", "--ids", list.c_str() };
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(3, argv, args_initializer);
+		benchmark::DoNotOptimize(args[ids].data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK(BM_ParseListOption)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+void BM_SplitList(benchmark::State& state)
+{
+	const auto list = MakeIdsList(state.range(0));
+	for (auto _ : state)
+	{
+		size_t size = 0;
+		SplitList(
+			list,
+			',',
+			[&size](std::string_view item)
+			{
+				size += item.size();
+				return true;
+			});
+		benchmark::DoNotOptimize(size);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK(BM_SplitList)->Arg(1000000);
+
+// Baseline: delimiters are searched with string_view::find.
+void BM_SplitListFind(benchmark::State& state)
+{
+	const auto list_storage = MakeIdsList(state.range(0));
+	const std::string_view list = list_storage;
+	for (auto _ : state)
+	{
+		size_t size = 0;
+		size_t begin = 0;
+		for (auto pos = list.find(','); ; pos = list.find(',', begin))
+		{
+			size += list.substr(begin, pos - begin).size();
+			if (pos == std::string_view::npos)
+			{
+				break;
+			}
+			begin = pos + 1;
+		}
+		benchmark::DoNotOptimize(size);
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(list.size()));
+}
+BENCHMARK(BM_SplitListFind)->Arg(1000000);
+
+} // namespace
+
+} // namespace SimpleArgsParser
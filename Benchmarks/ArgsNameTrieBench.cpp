@@ -0,0 +1,68 @@
+#include <ArgsParser.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+void AddOptions(ArgsInitializer& args_initializer, int64_t options_count)
+{
+	for (int64_t i = 0; i < options_count; ++i)
+	{
+		args_initializer("plugin" + std::to_string(i % 37) + "-option" + std::to_string(i), "Help", ArgValue<int>());
+	}
+}
+
+void BM_FindArgInfosByPrefix(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	AddOptions(args_initializer, state.range(0));
+	args_initializer.Freeze();
+
+	const auto prefix = "--plugin3-option" + std::to_string(state.range(0) - 4);
+	for (auto _ : state)
+	{
+		bool ambiguous = false;
+		benchmark::DoNotOptimize(args_initializer.FindArgInfosByPrefix(prefix, ambiguous));
+	}
+}
+BENCHMARK(BM_FindArgInfosByPrefix)->Arg(1000)->Arg(10000);
+
+// Frozen initializer searches suggestions in the name trie.
+void BM_FindSimilarNamesTrie(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	AddOptions(args_initializer, state.range(0));
+	args_initializer.Freeze();
+
+	for (auto _ : state)
+	{
+		auto names = args_initializer.FindSimilarNames("--plugin3-optoin40", 3);
+		benchmark::DoNotOptimize(names.data());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FindSimilarNamesTrie)->Arg(1000)->Arg(10000)->Complexity();
+
+// Not frozen initializer compares the token with every name.
+void BM_FindSimilarNamesScan(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	AddOptions(args_initializer, state.range(0));
+
+	for (auto _ : state)
+	{
+		auto names = args_initializer.FindSimilarNames("--plugin3-optoin40", 3);
+		benchmark::DoNotOptimize(names.data());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FindSimilarNamesScan)->Arg(1000)->Arg(10000)->Complexity();
+
+} // namespace
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,107 @@
+#include "AllocationCounter.h"
+
+#include <ArgsValueStore.h>
+#include <benchmark/benchmark.h>
+
+#include <any>
+#include <map>
+#include <string>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+constexpr size_t options_count = 200;
+
+const std::string string_value = "string value which doesn't fit in SSO buffer";
+
+std::string GetName(size_t index)
+{
+	return "--option" + std::to_string(index);
+}
+
+// Storage used by ArgsContainer before, kept as a baseline.
+std::map<std::string, std::any> MakeAnyMap()
+{
+	std::map<std::string, std::any> values;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		switch (i % 4)
+		{
+		case 0: values.emplace(GetName(i), static_cast<int>(i)); break;
+		case 1: values.emplace(GetName(i), static_cast<double>(i)); break;
+		case 2: values.emplace(GetName(i), string_value); break;
+		default: values.emplace(GetName(i), true); break;
+		}
+	}
+	return values;
+}
+
+ArgsValueStore MakeValueStore()
+{
+	ArgsValueStore values(options_count);
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		switch (i % 4)
+		{
+		case 0: values.Set(i, static_cast<int>(i)); break;
+		case 1: values.Set(i, static_cast<double>(i)); break;
+		case 2: values.Set(i, string_value); break;
+		default: values.Set(i, true); break;
+		}
+	}
+	return values;
+}
+
+template<typename Storage>
+void ReportMemory(benchmark::State& state, Storage (*make_storage)())
+{
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		AllocationCounter counter;
+		auto values = make_storage();
+		bytes = counter.GetBytes() + sizeof(values);
+		benchmark::DoNotOptimize(values);
+	}
+	state.counters["bytes_per_option"] = static_cast<double>(bytes) / options_count;
+}
+
+void BM_AnyMapMemory(benchmark::State& state)
+{
+	ReportMemory(state, &MakeAnyMap);
+}
+BENCHMARK(BM_AnyMapMemory);
+
+void BM_ArgsValueStoreMemory(benchmark::State& state)
+{
+	ReportMemory(state, &MakeValueStore);
+}
+BENCHMARK(BM_ArgsValueStoreMemory);
+
+void BM_AnyMapRead(benchmark::State& state)
+{
+	const auto values = MakeAnyMap();
+	const auto name = GetName(100);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::any_cast<int>(values.at(name)));
+	}
+}
+BENCHMARK(BM_AnyMapRead);
+
+void BM_ArgsValueStoreRead(benchmark::State& state)
+{
+	const auto values = MakeValueStore();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(*values.Get<int>(100));
+	}
+}
+BENCHMARK(BM_ArgsValueStoreRead);
+
+} // namespace
+
+} // namespace SimpleArgsParser
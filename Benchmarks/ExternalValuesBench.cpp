@@ -0,0 +1,90 @@
+#include <ArgsParser.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+std::string GetEnvName(int64_t index)
+{
+	return "SIMPLE_ARGS_PARSER_BENCH_" + std::to_string(index);
+}
+
+// Even options are bound to the environment, odd ones to the config file.
+void BM_ParseArgsEnvAndConfig(benchmark::State& state)
+{
+	const auto config_path = (std::filesystem::temp_directory_path() / "simple_args_parser_bench.ini").string();
+	std::ofstream config(config_path, std::ios::binary);
+	config << "[options]\n";
+
+	ArgsInitializer args_initializer;
+	for (int64_t i = 0; i < state.range(0); ++i)
+	{
+		const auto name = "option" + std::to_string(i);
+		if (i % 2 == 0)
+		{
+			::setenv(GetEnvName(i).c_str(), std::to_string(i).c_str(), 1);
+			args_initializer(name, "Help", ArgValue<int>(), ArgOptions().SetEnv(GetEnvName(i)));
+		}
+		else
+		{
+			config << name << " = " << i << "\n";
+			args_initializer(name, "Help", ArgValue<int>(), ArgOptions().SetConfigKey("options." + name));
+		}
+	}
+	config.close();
+	args_initializer.SetConfigFile(config_path);
+	args_initializer.Freeze();
+
+	const char* argv[] = { "program" };
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(1, argv, args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+	}
+
+	for (int64_t i = 0; i < state.range(0); i += 2)
+	{
+		::unsetenv(GetEnvName(i).c_str());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParseArgsEnvAndConfig)->Arg(10)->Arg(100)->Arg(1000)->Complexity();
+
+// Baseline: one getenv per bound option, every call scans the whole environment.
+void BM_GetenvPerOption(benchmark::State& state)
+{
+	std::vector<std::string> names;
+	for (int64_t i = 0; i < state.range(0); ++i)
+	{
+		names.push_back(GetEnvName(i));
+		::setenv(names.back().c_str(), std::to_string(i).c_str(), 1);
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto& name : names)
+		{
+			benchmark::DoNotOptimize(std::getenv(name.c_str()));
+		}
+	}
+
+	for (const auto& name : names)
+	{
+		::unsetenv(name.c_str());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GetenvPerOption)->Arg(10)->Arg(100)->Arg(1000)->Complexity();
+
+} // namespace
+
+} // namespace SimpleArgsParser
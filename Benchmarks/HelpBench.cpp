@@ -0,0 +1,81 @@
+#include <ArgsParser.h>
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+void AddOptions(ArgsInitializer& args_initializer, int64_t options_count, size_t help_words)
+{
+	for (int64_t i = 0; i < options_count; ++i)
+	{
+		const auto name = "option" + std::to_string(i) + ",o" + std::to_string(i);
+		std::string help = "Help for option " + std::to_string(i);
+		for (size_t j = 0; j < help_words; ++j)
+		{
+			help += " which is long enough to be wrapped";
+		}
+		args_initializer(name, help, ArgValue<int>().SetDefault(static_cast<int>(i)));
+	}
+}
+
+void BM_GetHelpString(benchmark::State& state)
+{
+	ArgsInitializer args_initializer("Benchmark program description.");
+	AddOptions(args_initializer, state.range(0), 2);
+	args_initializer.Freeze();
+
+	for (auto _ : state)
+	{
+		auto help = GetHelpString("program", args_initializer);
+		benchmark::DoNotOptimize(help.data());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GetHelpString)->Arg(10)->Arg(100)->Arg(1000)->Complexity();
+
+// Options with long help strings, layout is rendered on every call.
+void BM_WriteHelpNotFrozen(benchmark::State& state)
+{
+	ArgsInitializer args_initializer("Benchmark program description.");
+	AddOptions(args_initializer, state.range(0), 20);
+
+	std::ostringstream stream;
+	for (auto _ : state)
+	{
+		stream.str({});
+		WriteHelp(stream, "program", args_initializer);
+		benchmark::DoNotOptimize(stream.tellp());
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.str().size()));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WriteHelpNotFrozen)->Arg(250)->Arg(500)->Arg(1000)->Complexity(benchmark::oN);
+
+// Same options, layout is rendered once on Freeze.
+void BM_WriteHelpFrozen(benchmark::State& state)
+{
+	ArgsInitializer args_initializer("Benchmark program description.");
+	AddOptions(args_initializer, state.range(0), 20);
+	args_initializer.Freeze();
+
+	std::ostringstream stream;
+	for (auto _ : state)
+	{
+		stream.str({});
+		WriteHelp(stream, "program", args_initializer);
+		benchmark::DoNotOptimize(stream.tellp());
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.str().size()));
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WriteHelpFrozen)->Arg(250)->Arg(500)->Arg(1000)->Complexity(benchmark::oN);
+
+} // namespace
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,518 @@
+#include "AllocationCounter.h"
+
+#include <ArgsParser.h>
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+ArgsInitializer MakeInitializer(
+	size_t options_count,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+	ArgsInitializer args_initializer("Benchmark program description.", 40, 40, resource);
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		const auto name = "option" + std::to_string(i);
+		const auto help = "Help for " + name + " which is long enough to be wrapped on several lines of the help.";
+		if (i % 2 == 0)
+		{
+			args_initializer(name, help, ArgValue<int>().SetDefault(static_cast<int>(i)));
+		}
+		else
+		{
+			args_initializer(name, help);
+		}
+	}
+	return args_initializer;
+}
+
+void BM_ParseArgsWithoutHelp(benchmark::State& state)
+{
+	const auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+	const char* argv[] = { "program", "--option0", "12", "--option1" };
+
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(4, argv, args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+	}
+}
+BENCHMARK(BM_ParseArgsWithoutHelp)->Arg(10)->Arg(150);
+
+void BM_ParseArgsLongArgv(benchmark::State& state)
+{
+	const auto options_count = static_cast<size_t>(state.range(0));
+	auto args_initializer = MakeInitializer(options_count);
+	args_initializer.Freeze();
+
+	// Every option is set on the command line.
+	std::vector<std::string> tokens;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		tokens.push_back("--option" + std::to_string(i));
+		if (i % 2 == 0)
+		{
+			tokens.push_back(std::to_string(i));
+		}
+	}
+	std::vector<const char*> argv = { "program" };
+	for (const auto& token : tokens)
+	{
+		argv.push_back(token.c_str());
+	}
+
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(argv.size()));
+}
+BENCHMARK(BM_ParseArgsLongArgv)->Arg(10)->Arg(100)->Arg(1000);
+
+// range(1) selects "--optionN=value" (1) or "--optionN value" (0) form.
+void BM_ParseArgsAttachedValues(benchmark::State& state)
+{
+	const auto options_count = static_cast<size_t>(state.range(0));
+	ArgsInitializer args_initializer;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Help", ArgValue<int>());
+	}
+	args_initializer.Freeze();
+
+	std::vector<std::string> tokens;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		if (state.range(1) != 0)
+		{
+			tokens.push_back("--option" + std::to_string(i) + "=" + std::to_string(i));
+		}
+		else
+		{
+			tokens.push_back("--option" + std::to_string(i));
+			tokens.push_back(std::to_string(i));
+		}
+	}
+	std::vector<const char*> argv = { "program" };
+	for (const auto& token : tokens)
+	{
+		argv.push_back(token.c_str());
+	}
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationCounter counter;
+		const auto args = ParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		allocations = counter.GetCount();
+		benchmark::DoNotOptimize(args.Count());
+	}
+	state.counters["allocations"] = static_cast<double>(allocations);
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(options_count));
+}
+BENCHMARK(BM_ParseArgsAttachedValues)->Args({ 10, 0 })->Args({ 10, 1 })->Args({ 1000, 0 })->Args({ 1000, 1 });
+
+// range(0) selects "-abcdefgi" bundle (1) or separate short flags (0).
+void BM_ParseArgsShortFlagsBundle(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	const std::string names = "abcdefgi";
+	for (const auto name : names)
+	{
+		args_initializer(std::string("flag_") + name + "," + name, "Help");
+	}
+	args_initializer.Freeze();
+
+	const auto bundle = "-" + names;
+	std::vector<std::string> flags;
+	for (const auto name : names)
+	{
+		flags.push_back(std::string("-") + name);
+	}
+	std::vector<const char*> argv = { "program" };
+	if (state.range(0) != 0)
+	{
+		argv.push_back(bundle.c_str());
+	}
+	else
+	{
+		for (const auto& flag : flags)
+		{
+			argv.push_back(flag.c_str());
+		}
+	}
+
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+	}
+}
+BENCHMARK(BM_ParseArgsShortFlagsBundle)->Arg(0)->Arg(1);
+
+void BM_ParseArgsFrozen(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "12", "--option1" };
+
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(4, argv, args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+	}
+}
+BENCHMARK(BM_ParseArgsFrozen)->Arg(10)->Arg(150);
+
+// range(1) selects ParseArgs (0) or reparse into one ArgsParseContext (1).
+void BM_ParseArgsReuseContext(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "12", "--option1", "--option2", "7" };
+	ArgsParseContext context(args_initializer);
+
+	AllocationCounter counter;
+	for (auto _ : state)
+	{
+		if (state.range(1) == 0)
+		{
+			const auto args = ParseArgs(6, argv, args_initializer);
+			benchmark::DoNotOptimize(args.Count());
+		}
+		else
+		{
+			benchmark::DoNotOptimize(context.Parse(6, argv).Count());
+		}
+	}
+	state.counters["allocations"] = static_cast<double>(counter.GetCount()) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_ParseArgsReuseContext)->Args({ 10, 0 })->Args({ 10, 1 })->Args({ 150, 0 })->Args({ 150, 1 });
+
+// Parse of 200 options with defaults, half of them set in argv, and read of range(1) options
+// by handle, eager (range(0) == 0) and lazy conversion.
+void BM_ParseArgsConversion(benchmark::State& state)
+{
+	constexpr size_t options_count = 200;
+	ArgsInitializer args_initializer;
+	std::vector<ArgHandle<double>> number_handles;
+	std::vector<ArgHandle<std::string>> string_handles;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		const auto name = "option" + std::to_string(i);
+		if (i % 2 == 0)
+		{
+			number_handles.emplace_back();
+			args_initializer(name, "Number", ArgValue<double>().SetDefault(0.25), number_handles.back());
+		}
+		else
+		{
+			string_handles.emplace_back();
+			args_initializer(name, "String", ArgValue<std::string>().SetDefault("default value of the string option"), string_handles.back());
+		}
+	}
+	args_initializer.SetConversion(state.range(0) == 0 ? ArgsConversion::Eager : ArgsConversion::Lazy).Freeze();
+
+	std::vector<std::string> tokens;
+	for (size_t i = 0; i < options_count; i += 2)
+	{
+		tokens.push_back("--option" + std::to_string(i));
+		tokens.push_back(std::to_string(i) + ".125");
+		tokens.push_back("--option" + std::to_string(i + 1));
+		tokens.push_back("string value number " + std::to_string(i + 1));
+	}
+	std::vector<const char*> argv = { "program" };
+	for (size_t i = 0; i < tokens.size() / 2; ++i)
+	{
+		argv.push_back(tokens[i].c_str());
+	}
+
+	const auto read_count = static_cast<size_t>(state.range(1));
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		for (size_t i = 0; i < read_count; ++i)
+		{
+			if (i % 2 == 0)
+			{
+				benchmark::DoNotOptimize(args[number_handles[i / 2]]);
+			}
+			else
+			{
+				benchmark::DoNotOptimize(args[string_handles[i / 2]].size());
+			}
+		}
+	}
+}
+BENCHMARK(BM_ParseArgsConversion)
+	->Args({ 0, 0 })->Args({ 0, 10 })->Args({ 0, 200 })
+	->Args({ 1, 0 })->Args({ 1, 10 })->Args({ 1, 200 });
+
+// 50 exclusive pairs of 500 options checked by hand with Exist (range(0) == 0)
+// or by groups of the initializer.
+void BM_ParseArgsExclusiveGroups(benchmark::State& state)
+{
+	constexpr size_t options_count = 500;
+	constexpr size_t groups_count = 50;
+	const auto use_groups = state.range(0) != 0;
+	ArgsInitializer args_initializer;
+	std::vector<std::string> names;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		names.push_back("--option" + std::to_string(i));
+		args_initializer(names.back().substr(2), "Flag");
+	}
+	if (use_groups)
+	{
+		for (size_t i = 0; i < groups_count; ++i)
+		{
+			args_initializer.AddExclusiveGroup({ names[2 * i], names[2 * i + 1] });
+		}
+	}
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "--option3", "--option10" };
+
+	// Reused container, so the store of 500 values isn't allocated per parse.
+	ArgsParseContext context(args_initializer);
+	for (auto _ : state)
+	{
+		const auto& args = context.Parse(4, argv);
+		if (!use_groups)
+		{
+			for (size_t i = 0; i < groups_count; ++i)
+			{
+				if (args.Exist(names[2 * i]) && args.Exist(names[2 * i + 1]))
+				{
+					state.SkipWithError("Conflicting options.");
+				}
+			}
+		}
+		benchmark::DoNotOptimize(args.Count());
+	}
+}
+BENCHMARK(BM_ParseArgsExclusiveGroups)->Arg(0)->Arg(1);
+
+// Config of 8 options filled by copies of GetValue results (range(0) == 0)
+// or by TryParseArgsInto with options bound to the members.
+void BM_ParseArgsIntoConfig(benchmark::State& state)
+{
+	struct Config
+	{
+		int threads = 0;
+		int backlog = 0;
+		long long limit = 0;
+		double timeout = 0;
+		double ratio = 0;
+		std::string host;
+		std::string user;
+		std::vector<int> ids;
+	};
+	const auto bind = state.range(0) != 0;
+	const auto make_value = [bind](auto member)
+	{
+		using Type = std::remove_reference_t<decltype(std::declval<Config&>().*member)>;
+		ArgValue<Type> value;
+		if (bind)
+		{
+			value.BindTo(member);
+		}
+		return value;
+	};
+	ArgsInitializer args_initializer;
+	args_initializer("threads, j", "Threads", make_value(&Config::threads).SetDefault(4))
+	                ("backlog", "Backlog", make_value(&Config::backlog).SetDefault(128))
+	                ("limit", "Limit", make_value(&Config::limit).SetDefault(0))
+	                ("timeout", "Timeout", make_value(&Config::timeout).SetDefault(1.5))
+	                ("ratio", "Ratio", make_value(&Config::ratio).SetDefault(0.5))
+	                ("host", "Host", make_value(&Config::host).SetDefault("localhost"))
+	                ("user", "User", make_value(&Config::user).SetDefault("nobody"))
+	                ("ids", "Ids", make_value(&Config::ids).SetDefault({}));
+	args_initializer.Freeze();
+	const char* argv[] = {
+		"program", "-j", "16", "--backlog", "512", "--limit", "1000000", "--timeout=2.5",
+		"--host", "example.org", "--user", "www", "--ids", "1,2,3" };
+	constexpr int argc = sizeof(argv) / sizeof(argv[0]);
+
+	Config config;
+	AllocationCounter counter;
+	for (auto _ : state)
+	{
+		if (bind)
+		{
+			bool help_requested = false;
+			const auto error = TryParseArgsInto(argc, argv, args_initializer, config, help_requested);
+			benchmark::DoNotOptimize(error.GetCode());
+		}
+		else
+		{
+			const auto args = ParseArgs(argc, argv, args_initializer);
+			config.threads = args.GetValue<int>("--threads");
+			config.backlog = args.GetValue<int>("--backlog");
+			config.limit = args.GetValue<long long>("--limit");
+			config.timeout = args.GetValue<double>("--timeout");
+			config.ratio = args.GetValue<double>("--ratio");
+			config.host = args.GetValue<std::string>("--host");
+			config.user = args.GetValue<std::string>("--user");
+			config.ids = args.GetValue<std::vector<int>>("--ids");
+		}
+		benchmark::DoNotOptimize(config.threads);
+	}
+	state.counters["allocations"] = static_cast<double>(counter.GetCount()) / static_cast<double>(state.iterations());
+	state.SetItemsProcessed(state.iterations() * argc);
+}
+BENCHMARK(BM_ParseArgsIntoConfig)->Arg(0)->Arg(1);
+
+void BM_ResolveOptionNames(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+	if (state.range(1) != 0)
+	{
+		args_initializer.Freeze();
+	}
+	std::vector<std::string> names;
+	for (int64_t i = 0; i < state.range(0); ++i)
+	{
+		names.push_back("--option" + std::to_string(i));
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto& name : names)
+		{
+			benchmark::DoNotOptimize(args_initializer.FindArgInfos(name));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResolveOptionNames)->Args({ 150, 0 })->Args({ 150, 1 })->Args({ 1000, 0 })->Args({ 1000, 1 });
+
+void BM_GetValueByName(benchmark::State& state)
+{
+	const auto args_initializer = MakeInitializer(150);
+	const char* argv[] = { "program", "--option0", "12", "--option1" };
+	const auto args = ParseArgs(4, argv, args_initializer);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(args.GetValue<int>("--option100"));
+	}
+}
+BENCHMARK(BM_GetValueByName);
+
+void BM_GetValueByHandle(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(150);
+	ArgHandle<int> handle;
+	args_initializer("handle_option", "Help", ArgValue<int>().SetDefault(5), handle);
+	const char* argv[] = { "program", "--option0", "12", "--option1" };
+	const auto args = ParseArgs(4, argv, args_initializer);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(args[handle]);
+	}
+}
+BENCHMARK(BM_GetValueByHandle);
+
+void BM_BuildInitializer(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+		benchmark::DoNotOptimize(args_initializer.GetArgsCount());
+	}
+}
+BENCHMARK(BM_BuildInitializer)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_BuildInitializerMonotonic(benchmark::State& state)
+{
+	std::vector<std::byte> buffer(1 << 20);
+	for (auto _ : state)
+	{
+		std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size());
+		auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)), &resource);
+		benchmark::DoNotOptimize(args_initializer.GetArgsCount());
+	}
+}
+BENCHMARK(BM_BuildInitializerMonotonic)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_ParseArgsMonotonic(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "12", "--option1" };
+	std::vector<std::byte> buffer(1 << 16);
+
+	for (auto _ : state)
+	{
+		std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size());
+		const auto args = ParseArgs(4, argv, args_initializer, &resource);
+		benchmark::DoNotOptimize(args.Count());
+	}
+}
+BENCHMARK(BM_ParseArgsMonotonic)->Arg(10)->Arg(150);
+
+void BM_ParseArgsInvalidInput(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(10);
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "abc" };
+
+	for (auto _ : state)
+	{
+		try
+		{
+			const auto args = ParseArgs(3, argv, args_initializer);
+			benchmark::DoNotOptimize(args.Count());
+		}
+		catch (const ArgsParserException& exc)
+		{
+			benchmark::DoNotOptimize(exc.what());
+		}
+	}
+}
+BENCHMARK(BM_ParseArgsInvalidInput);
+
+void BM_TryParseArgsInvalidInput(benchmark::State& state)
+{
+	auto args_initializer = MakeInitializer(10);
+	args_initializer.Freeze();
+	const char* argv[] = { "program", "--option0", "abc" };
+
+	for (auto _ : state)
+	{
+		const auto result = TryParseArgs(3, argv, args_initializer);
+		benchmark::DoNotOptimize(result.GetError().GetCode());
+	}
+}
+BENCHMARK(BM_TryParseArgsInvalidInput);
+
+void BM_ParseArgsAndReadHelp(benchmark::State& state)
+{
+	const auto args_initializer = MakeInitializer(static_cast<size_t>(state.range(0)));
+	const char* argv[] = { "program", "--option0", "12", "--option1" };
+
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(4, argv, args_initializer);
+		auto help = args.GetValue<std::string>("--help");
+		benchmark::DoNotOptimize(help);
+	}
+}
+BENCHMARK(BM_ParseArgsAndReadHelp)->Arg(10)->Arg(150);
+
+} // namespace
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,113 @@
+#include <ArgsParser.h>
+#include <ArgsResponseFiles.h>
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+constexpr size_t options_count = 16;
+constexpr size_t file_size = 100 * 1024 * 1024;
+
+// Response file of ~100 MB with "--optionN value" pairs, written once per run.
+const std::string& GetResponseFile()
+{
+	static const std::string path = []()
+	{
+		const auto file_path = (std::filesystem::temp_directory_path() / "simple_args_parser_bench.rsp").string();
+		std::error_code error;
+		const auto existing_size = std::filesystem::file_size(file_path, error);
+		if (!error && existing_size >= file_size)
+		{
+			return file_path;
+		}
+
+		std::string chunk;
+		for (size_t i = 0; chunk.size() < 1024 * 1024; ++i)
+		{
+			chunk += "--option" + std::to_string(i % options_count) + " " + std::to_string(i * 7919) + "\n";
+		}
+		std::ofstream file(file_path, std::ios::binary);
+		for (size_t written = 0; written < file_size; written += chunk.size())
+		{
+			file << chunk;
+		}
+		return file_path;
+	}();
+	return path;
+}
+
+int64_t GetFileSize(const std::string& path)
+{
+	return static_cast<int64_t>(std::filesystem::file_size(path));
+}
+
+// Baseline: plain read of the file into a reused buffer.
+void BM_ReadResponseFileRaw(benchmark::State& state)
+{
+	const auto& path = GetResponseFile();
+	std::vector<char> buffer(1024 * 1024);
+	for (auto _ : state)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		size_t checksum = 0;
+		for (ssize_t size = 0; (size = ::read(fd, buffer.data(), buffer.size())) > 0;)
+		{
+			checksum += static_cast<size_t>(buffer[static_cast<size_t>(size) - 1]);
+		}
+		::close(fd);
+		benchmark::DoNotOptimize(checksum);
+	}
+	state.SetBytesProcessed(state.iterations() * GetFileSize(path));
+}
+BENCHMARK(BM_ReadResponseFileRaw)->Unit(benchmark::kMillisecond);
+
+void BM_ExpandResponseFile(benchmark::State& state)
+{
+	const auto path = "@" + GetResponseFile();
+	const char* argv[] = { "program", path.c_str() };
+	for (auto _ : state)
+	{
+		ArgsResponseFiles response_files;
+		const auto error = response_files.Expand(2, argv);
+		benchmark::DoNotOptimize(response_files.GetTokens().size());
+		benchmark::DoNotOptimize(error.GetCode());
+	}
+	state.SetBytesProcessed(state.iterations() * GetFileSize(GetResponseFile()));
+}
+BENCHMARK(BM_ExpandResponseFile)->Unit(benchmark::kMillisecond);
+
+void BM_ParseArgsResponseFile(benchmark::State& state)
+{
+	ArgsInitializer args_initializer;
+	for (size_t i = 0; i < options_count; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Help", ArgValue<long long>());
+	}
+	args_initializer.EnableResponseFiles();
+	args_initializer.Freeze();
+
+	const auto path = "@" + GetResponseFile();
+	const char* argv[] = { "program", path.c_str() };
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(2, argv, args_initializer);
+		benchmark::DoNotOptimize(args.Count());
+	}
+	state.SetBytesProcessed(state.iterations() * GetFileSize(GetResponseFile()));
+}
+BENCHMARK(BM_ParseArgsResponseFile)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+} // namespace SimpleArgsParser
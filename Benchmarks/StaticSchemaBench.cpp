@@ -0,0 +1,132 @@
+#include "AllocationCounter.h"
+
+#include <ArgsParser.h>
+#include <ArgsStaticSchema.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+struct ServerOptions
+{
+	int port = 0;
+	int threads = 0;
+	int backlog = 0;
+	double timeout = 0;
+	std::string host;
+	std::string root;
+	std::string log;
+	bool verbose = false;
+	bool daemon = false;
+	std::vector<int> ids;
+};
+
+constexpr auto server_schema = MakeStaticSchema(
+	"Server.",
+	StaticArg<&ServerOptions::port>("port, p", "Port to listen on").SetRequired(),
+	StaticArg<&ServerOptions::threads>("threads, j", "Worker threads").SetDefault(4),
+	StaticArg<&ServerOptions::backlog>("backlog", "Listen backlog").SetDefault(128),
+	StaticArg<&ServerOptions::timeout>("timeout", "Timeout in seconds").SetDefault(1.5),
+	StaticArg<&ServerOptions::host>("host", "Host name").SetDefault("localhost"),
+	StaticArg<&ServerOptions::root>("root, r", "Document root"),
+	StaticArg<&ServerOptions::log>("log", "Log file"),
+	StaticFlag<&ServerOptions::verbose>("verbose, v", "Verbose output"),
+	StaticFlag<&ServerOptions::daemon>("daemon, d", "Run in background"),
+	StaticArg<&ServerOptions::ids>("ids", "Ids"));
+
+ArgsInitializer MakeServerInitializer()
+{
+	ArgsInitializer args_initializer("Server.");
+	args_initializer("port, p", "Port to listen on", ArgValue<int>(), ArgOptions().SetRequired())
+	                ("threads, j", "Worker threads", ArgValue<int>().SetDefault(4))
+	                ("backlog", "Listen backlog", ArgValue<int>().SetDefault(128))
+	                ("timeout", "Timeout in seconds", ArgValue<double>().SetDefault(1.5))
+	                ("host", "Host name", ArgValue<std::string>().SetDefault("localhost"))
+	                ("root, r", "Document root", ArgValue<std::string>())
+	                ("log", "Log file", ArgValue<std::string>())
+	                ("verbose, v", "Verbose output")
+	                ("daemon, d", "Run in background")
+	                ("ids", "Ids", ArgValue<std::vector<int>>());
+	args_initializer.Freeze();
+	return args_initializer;
+}
+
+const char* server_argv[] = {
+	"program", "--port", "8080", "-j", "16", "--timeout=2.5", "--host", "example.org",
+	"-r", "/var/www", "--log", "server.log", "-vd", "--ids", "1,2,3" };
+constexpr int server_argc = sizeof(server_argv) / sizeof(server_argv[0]);
+
+// Startup cost of the runtime schema, the static one is built by the compiler.
+void BM_InitializerConstruction(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		const auto args_initializer = MakeServerInitializer();
+		benchmark::DoNotOptimize(args_initializer.GetArgsCount());
+	}
+}
+BENCHMARK(BM_InitializerConstruction);
+
+void BM_ParseArgsServer(benchmark::State& state)
+{
+	const auto args_initializer = MakeServerInitializer();
+	AllocationCounter counter;
+	for (auto _ : state)
+	{
+		const auto args = ParseArgs(server_argc, server_argv, args_initializer);
+		benchmark::DoNotOptimize(args.GetValue<int>("--port"));
+	}
+	state.counters["allocations"] = static_cast<double>(counter.GetCount()) / static_cast<double>(state.iterations());
+	state.SetItemsProcessed(state.iterations() * server_argc);
+}
+BENCHMARK(BM_ParseArgsServer);
+
+void BM_ParseStaticArgsServer(benchmark::State& state)
+{
+	AllocationCounter counter;
+	for (auto _ : state)
+	{
+		const auto options = ParseStaticArgs(server_argc, server_argv, server_schema);
+		benchmark::DoNotOptimize(options.port);
+	}
+	state.counters["allocations"] = static_cast<double>(counter.GetCount()) / static_cast<double>(state.iterations());
+	state.SetItemsProcessed(state.iterations() * server_argc);
+}
+BENCHMARK(BM_ParseStaticArgsServer);
+
+void BM_StaticSchemaFind(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		for (int i = 1; i < server_argc; ++i)
+		{
+			benchmark::DoNotOptimize(server_schema.Find(server_argv[i]));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (server_argc - 1));
+}
+BENCHMARK(BM_StaticSchemaFind);
+
+void BM_InitializerFind(benchmark::State& state)
+{
+	const auto args_initializer = MakeServerInitializer();
+	for (auto _ : state)
+	{
+		for (int i = 1; i < server_argc; ++i)
+		{
+			benchmark::DoNotOptimize(args_initializer.FindArgInfos(server_argv[i]));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * (server_argc - 1));
+}
+BENCHMARK(BM_InitializerFind);
+
+} // namespace
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,79 @@
+#include <ArgsParser.h>
+#include <ArgsSubcommands.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+constexpr size_t subcommands_count = 40;
+constexpr size_t subcommand_options_count = 50;
+
+void AddSubcommandOptions(ArgsInitializer& args_initializer)
+{
+	for (size_t i = 0; i < subcommand_options_count; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Option", ArgValue<int>().SetDefault(0));
+	}
+}
+
+ArgsInitializer MakeGlobalInitializer()
+{
+	ArgsInitializer args_initializer("Tool.");
+	args_initializer("threads, j", "Threads", ArgValue<int>().SetDefault(1))
+	                ("verbose, v", "Verbose");
+	args_initializer.Freeze();
+	return args_initializer;
+}
+
+const char* subcommand_argv[] = { "tool", "-v", "command7", "--option3", "3", "--option42", "42" };
+constexpr int subcommand_argc = sizeof(subcommand_argv) / sizeof(subcommand_argv[0]);
+
+// All subcommand initializers are built up front, as a single schema would be.
+void BM_SubcommandsEager(benchmark::State& state)
+{
+	const auto global_initializer = MakeGlobalInitializer();
+	for (auto _ : state)
+	{
+		std::vector<ArgsInitializer> initializers(subcommands_count);
+		for (auto& args_initializer : initializers)
+		{
+			AddSubcommandOptions(args_initializer);
+			args_initializer.Freeze();
+		}
+		size_t subcommand_index = 0;
+		const auto global_args = TryParseArgsPrefix(subcommand_argc, subcommand_argv, global_initializer, subcommand_index);
+		const auto args = ParseArgs(
+			subcommand_argc - static_cast<int>(subcommand_index),
+			subcommand_argv + subcommand_index,
+			initializers[7]);
+		benchmark::DoNotOptimize(args.Count());
+	}
+}
+BENCHMARK(BM_SubcommandsEager);
+
+// Only the invoked subcommand is built.
+void BM_SubcommandsLazy(benchmark::State& state)
+{
+	const auto global_initializer = MakeGlobalInitializer();
+	for (auto _ : state)
+	{
+		ArgsSubcommands subcommands(global_initializer);
+		for (size_t i = 0; i < subcommands_count; ++i)
+		{
+			subcommands.Add("command" + std::to_string(i), "Command", AddSubcommandOptions);
+		}
+		const auto result = subcommands.Parse(subcommand_argc, subcommand_argv);
+		benchmark::DoNotOptimize(result.GetSubcommandArgs().Count());
+	}
+}
+BENCHMARK(BM_SubcommandsLazy);
+
+} // namespace
+
+} // namespace SimpleArgsParser
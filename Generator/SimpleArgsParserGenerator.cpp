@@ -0,0 +1,593 @@
+// Generates a header with a static parser from a schema file:
+//   SimpleArgsParserGenerator <schema file> <output header>
+//
+// Schema is an INI file. Keys before the first section describe the result:
+//   struct = ServerOptions          name of the generated struct (required)
+//   namespace = server              namespace of the struct
+//   description = Example server.   description of help
+//   include = Point.h               header with user types, may be repeated
+//   help_desc_width = 40            width of the options column of help
+//   help_info_width = 40            width of the help column of help
+// Every section is an option named as the section:
+//   [port]
+//   short = p
+//   type = int                      flag, bool, int, unsigned, long, int64,
+//                                   uint64, size_t, float, double, string,
+//                                   list<T> or a user type with ParseFromString
+//   default = 80
+//   required = true
+//   help = Port to listen on.
+//   member = port                   defaults to the name with '-' replaced by '_'
+//   delimiter = ;                   delimiter of list items
+#include <ArgsExternalValues.h>
+#include <ArgsParser.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+struct OptionSpec
+{
+	std::string name;
+	std::string short_name;
+	std::string type = "string";
+	std::string default_value;
+	bool has_default = false;
+	bool required = false;
+	std::string help;
+	std::string member;
+	std::string delimiter;
+};
+
+struct SchemaSpec
+{
+	std::string struct_name;
+	std::string namespace_name;
+	std::string description;
+	std::vector<std::string> includes;
+	size_t help_desc_width = 40;
+	size_t help_info_width = 40;
+	std::vector<OptionSpec> options;
+};
+
+// C++ type of the member and literal of the default for a schema type.
+struct TypeInfo
+{
+	std::string cpp_type;
+	// Adds the option to the initializer, which checks names and renders help.
+	// Returns the default as C++ literal.
+	std::function<std::string(ArgsInitializer&, const OptionSpec&)> add_option;
+};
+
+std::string EscapeString(std::string_view value)
+{
+	std::string result = "\"";
+	for (const auto symbol : value)
+	{
+		switch (symbol)
+		{
+		case '"':
+			result += "\\\"";
+			break;
+		case '\\':
+			result += "\\\\";
+			break;
+		case '\n':
+			result += "\\n";
+			break;
+		case '\t':
+			result += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(symbol) < 0x20)
+			{
+				// Octal escape has at most 3 digits, so it doesn't swallow the next symbol.
+				const auto code = static_cast<unsigned char>(symbol);
+				result += '\\';
+				result += static_cast<char>('0' + code / 64);
+				result += static_cast<char>('0' + code / 8 % 8);
+				result += static_cast<char>('0' + code % 8);
+			}
+			else
+			{
+				result += symbol;
+			}
+		}
+	}
+	result += '"';
+	return result;
+}
+
+std::string EscapeChar(char symbol)
+{
+	if (symbol == '\'' || symbol == '\\')
+	{
+		return std::string("'\\") + symbol + "'";
+	}
+	return std::string("'") + symbol + "'";
+}
+
+bool IsIdentifier(std::string_view value)
+{
+	if (value.empty() || std::isdigit(static_cast<unsigned char>(value.front())))
+	{
+		return false;
+	}
+	for (const auto symbol : value)
+	{
+		if (!std::isalnum(static_cast<unsigned char>(symbol)) && symbol != '_')
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IsNamespace(std::string_view value)
+{
+	while (true)
+	{
+		const auto pos = value.find("::");
+		if (!IsIdentifier(value.substr(0, pos)))
+		{
+			return false;
+		}
+		if (pos == std::string_view::npos)
+		{
+			return true;
+		}
+		value.remove_prefix(pos + 2);
+	}
+}
+
+ArgOptions MakeArgOptions(const OptionSpec& option)
+{
+	ArgOptions arg_options;
+	if (option.required)
+	{
+		arg_options.SetRequired();
+	}
+	return arg_options;
+}
+
+std::string GetOptionName(const OptionSpec& option)
+{
+	return option.short_name.empty() ? option.name : option.name + ", " + option.short_name;
+}
+
+template<typename Type>
+std::string AddArithmeticOption(ArgsInitializer& args_initializer, const OptionSpec& option)
+{
+	ArgValue<Type> value;
+	std::string literal;
+	if (option.has_default)
+	{
+		Type default_value{};
+		const auto status = ConvertFromString(option.default_value, default_value);
+		if (status != ConvertStatus::Ok)
+		{
+			throw ArgsInitializerException(
+				"Incorrect default value of option " + option.name + ": " + GetConvertErrorMessage(option.default_value, status));
+		}
+		value.SetDefault(default_value);
+
+		if constexpr (std::is_same_v<Type, bool>)
+		{
+			literal = default_value ? "true" : "false";
+		}
+		else if constexpr (std::is_floating_point_v<Type>)
+		{
+			if (!std::isfinite(default_value))
+			{
+				throw ArgsInitializerException("Default value of option " + option.name + " must be finite.");
+			}
+			// Shortest representation which is read back to the same value.
+			char buffer[64];
+			const auto result = std::to_chars(buffer, buffer + sizeof(buffer), default_value);
+			literal.assign(buffer, result.ptr);
+		}
+		else if constexpr (std::is_signed_v<Type>)
+		{
+			// Literal of the minimum is negated maximum + 1, which doesn't fit the type.
+			literal = default_value == std::numeric_limits<Type>::min()
+				? "(" + std::to_string(default_value + 1) + " - 1)"
+				: std::to_string(default_value);
+		}
+		else
+		{
+			literal = std::to_string(default_value) + 'u';
+		}
+	}
+	args_initializer(GetOptionName(option), option.help, std::move(value), MakeArgOptions(option));
+	return literal;
+}
+
+std::string AddStringOption(ArgsInitializer& args_initializer, const OptionSpec& option)
+{
+	ArgValue<std::string> value;
+	if (option.has_default)
+	{
+		value.SetDefault(option.default_value);
+	}
+	args_initializer(GetOptionName(option), option.help, std::move(value), MakeArgOptions(option));
+	return option.has_default ? EscapeString(option.default_value) : std::string();
+}
+
+// List and user type options are validated as strings, they can't have defaults.
+std::string AddOptionWithoutDefault(ArgsInitializer& args_initializer, const OptionSpec& option)
+{
+	if (option.has_default)
+	{
+		throw ArgsInitializerException(
+			"Option " + option.name + " of type " + option.type + " can't have default value.");
+	}
+	args_initializer(GetOptionName(option), option.help, ArgValue<std::string>(), MakeArgOptions(option));
+	return std::string();
+}
+
+std::string AddFlagOption(ArgsInitializer& args_initializer, const OptionSpec& option)
+{
+	if (option.has_default)
+	{
+		throw ArgsInitializerException("Flag " + option.name + " can't have default value.");
+	}
+	args_initializer(GetOptionName(option), option.help, MakeArgOptions(option));
+	return std::string();
+}
+
+const std::map<std::string, TypeInfo, std::less<>>& GetBuiltinTypes()
+{
+	static const std::map<std::string, TypeInfo, std::less<>> types = {
+		{ "flag", { "bool", AddFlagOption } },
+		{ "bool", { "bool", AddArithmeticOption<bool> } },
+		{ "int", { "int", AddArithmeticOption<int> } },
+		{ "unsigned", { "unsigned", AddArithmeticOption<unsigned> } },
+		{ "long", { "long", AddArithmeticOption<long> } },
+		{ "int64", { "int64_t", AddArithmeticOption<int64_t> } },
+		{ "uint64", { "uint64_t", AddArithmeticOption<uint64_t> } },
+		{ "size_t", { "size_t", AddArithmeticOption<size_t> } },
+		{ "float", { "float", AddArithmeticOption<float> } },
+		{ "double", { "double", AddArithmeticOption<double> } },
+		{ "string", { "std::string", AddStringOption } }
+	};
+	return types;
+}
+
+TypeInfo GetTypeInfo(std::string_view type)
+{
+	const auto& types = GetBuiltinTypes();
+	if (const auto it = types.find(type); it != types.end())
+	{
+		return it->second;
+	}
+	if (type.substr(0, 5) == "list<" && type.size() > 6 && type.back() == '>')
+	{
+		const auto item_type = type.substr(5, type.size() - 6);
+		if (item_type == "flag" || item_type.substr(0, 5) == "list<")
+		{
+			throw ArgsInitializerException("Incorrect list type " + std::string(type) + ".");
+		}
+		return { "std::vector<" + GetTypeInfo(item_type).cpp_type + ">", AddOptionWithoutDefault };
+	}
+	return { std::string(type), AddOptionWithoutDefault };
+}
+
+size_t ParseWidth(std::string_view value, std::string_view key)
+{
+	size_t result = 0;
+	if (ConvertFromString(value, result) != ConvertStatus::Ok || result == 0)
+	{
+		throw ArgsInitializerException("Incorrect " + std::string(key) + ": " + std::string(value) + ".");
+	}
+	return result;
+}
+
+bool ParseBool(std::string_view value, std::string_view key)
+{
+	bool result = false;
+	if (ConvertFromString(value, result) != ConvertStatus::Ok)
+	{
+		throw ArgsInitializerException("Incorrect " + std::string(key) + ": " + std::string(value) + ".");
+	}
+	return result;
+}
+
+SchemaSpec ParseSchema(std::string_view text)
+{
+	SchemaSpec schema;
+	std::map<std::string, size_t, std::less<>> option_indexes;
+	const auto incorrect_line = ParseConfigFile(
+		text,
+		[&schema, &option_indexes](std::string_view section, std::string_view key, std::string_view value)
+		{
+			if (section.empty())
+			{
+				if (key == "struct")
+				{
+					schema.struct_name = value;
+				}
+				else if (key == "namespace")
+				{
+					schema.namespace_name = value;
+				}
+				else if (key == "description")
+				{
+					schema.description = value;
+				}
+				else if (key == "include")
+				{
+					schema.includes.emplace_back(value);
+				}
+				else if (key == "help_desc_width")
+				{
+					schema.help_desc_width = ParseWidth(value, key);
+				}
+				else if (key == "help_info_width")
+				{
+					schema.help_info_width = ParseWidth(value, key);
+				}
+				else
+				{
+					throw ArgsInitializerException("Unknown schema key " + std::string(key) + ".");
+				}
+				return;
+			}
+
+			auto [it, inserted] = option_indexes.emplace(std::string(section), schema.options.size());
+			if (inserted)
+			{
+				schema.options.emplace_back();
+				schema.options.back().name = section;
+			}
+			auto& option = schema.options[it->second];
+			if (key == "short")
+			{
+				option.short_name = value;
+			}
+			else if (key == "type")
+			{
+				option.type = value;
+			}
+			else if (key == "default")
+			{
+				option.default_value = value;
+				option.has_default = true;
+			}
+			else if (key == "required")
+			{
+				option.required = ParseBool(value, key);
+			}
+			else if (key == "help")
+			{
+				option.help = value;
+			}
+			else if (key == "member")
+			{
+				option.member = value;
+			}
+			else if (key == "delimiter")
+			{
+				if (value.size() != 1)
+				{
+					throw ArgsInitializerException("Delimiter of option " + option.name + " must be one symbol.");
+				}
+				option.delimiter = value;
+			}
+			else
+			{
+				throw ArgsInitializerException("Unknown key " + std::string(key) + " of option " + option.name + ".");
+			}
+		});
+	if (incorrect_line != 0)
+	{
+		throw ArgsInitializerException("Incorrect line " + std::to_string(incorrect_line) + ".");
+	}
+
+	if (!IsIdentifier(schema.struct_name))
+	{
+		throw ArgsInitializerException("Incorrect struct name " + schema.struct_name + ".");
+	}
+	if (!schema.namespace_name.empty() && !IsNamespace(schema.namespace_name))
+	{
+		throw ArgsInitializerException("Incorrect namespace " + schema.namespace_name + ".");
+	}
+	if (schema.options.empty())
+	{
+		throw ArgsInitializerException("Schema has no options.");
+	}
+	for (auto& option : schema.options)
+	{
+		if (option.member.empty())
+		{
+			option.member = option.name;
+			std::replace(option.member.begin(), option.member.end(), '-', '_');
+		}
+		if (!IsIdentifier(option.member))
+		{
+			throw ArgsInitializerException("Incorrect member name " + option.member + " of option " + option.name + ".");
+		}
+		if (!option.delimiter.empty() && option.type.substr(0, 5) != "list<")
+		{
+			throw ArgsInitializerException("Delimiter is set only for list options.");
+		}
+	}
+	return schema;
+}
+
+void WriteStringLines(std::ostream& stream, std::string_view text, std::string_view indent)
+{
+	if (text.empty())
+	{
+		stream << indent << "\"\"";
+		return;
+	}
+	while (!text.empty())
+	{
+		const auto line_end = text.find('\n');
+		const auto size = line_end == std::string_view::npos ? text.size() : line_end + 1;
+		stream << indent << EscapeString(text.substr(0, size));
+		text.remove_prefix(size);
+		if (!text.empty())
+		{
+			stream << '\n';
+		}
+	}
+}
+
+std::string Generate(const SchemaSpec& schema, std::string_view schema_path)
+{
+	// Names, defaults and help are checked by the initializer, its help
+	// layout is the pre-rendered help of the generated parser.
+	ArgsInitializer args_initializer(schema.description, schema.help_desc_width, schema.help_info_width);
+	std::vector<std::string> cpp_types;
+	std::vector<std::string> default_literals;
+	for (const auto& option : schema.options)
+	{
+		auto type_info = GetTypeInfo(option.type);
+		default_literals.push_back(type_info.add_option(args_initializer, option));
+		cpp_types.push_back(std::move(type_info.cpp_type));
+	}
+	args_initializer.Freeze();
+
+	std::string schema_variable;
+	for (const auto symbol : schema.struct_name)
+	{
+		if (std::isupper(static_cast<unsigned char>(symbol)) && !schema_variable.empty())
+		{
+			schema_variable += '_';
+		}
+		schema_variable += static_cast<char>(std::tolower(static_cast<unsigned char>(symbol)));
+	}
+	const auto help_variable = schema_variable + "_help";
+	schema_variable += "_schema";
+	const auto& name = schema.struct_name;
+
+	std::ostringstream stream;
+	stream << "// Generated by SimpleArgsParserGenerator from " << schema_path << ", don't edit.\n"
+		<< "#pragma once\n\n"
+		<< "#include <ArgsStaticSchema.h>\n";
+	for (const auto& include : schema.includes)
+	{
+		stream << "#include \"" << include << "\"\n";
+	}
+	stream << "\n#include <cstddef>\n#include <cstdint>\n#include <string>\n#include <string_view>\n#include <vector>\n\n";
+	if (!schema.namespace_name.empty())
+	{
+		stream << "namespace " << schema.namespace_name << "\n{\n\n";
+	}
+
+	stream << "struct " << name << "\n{\n";
+	for (size_t i = 0; i < schema.options.size(); ++i)
+	{
+		stream << '\t' << cpp_types[i] << ' ' << schema.options[i].member << "{};\n";
+	}
+	stream << "\n\tstatic SimpleArgsParser::StaticArgsParseResult<" << name << "> TryParse(const int argc, const char* const* argv);\n"
+		<< "\tstatic " << name << " Parse(const int argc, const char* const* argv);\n"
+		<< "\tstatic std::string GetHelp(std::string_view program_name);\n"
+		<< "};\n\n";
+
+	stream << "inline constexpr auto " << schema_variable << " = SimpleArgsParser::MakeStaticSchema(\n\t"
+		<< EscapeString(schema.description);
+	for (size_t i = 0; i < schema.options.size(); ++i)
+	{
+		const auto& option = schema.options[i];
+		stream << ",\n\tSimpleArgsParser::" << (option.type == "flag" ? "StaticFlag" : "StaticArg")
+			<< "<&" << name << "::" << option.member << ">("
+			<< EscapeString(GetOptionName(option)) << ", " << EscapeString(option.help) << ')';
+		if (option.required)
+		{
+			stream << ".SetRequired()";
+		}
+		if (!default_literals[i].empty())
+		{
+			stream << ".SetDefault(" << default_literals[i] << ')';
+		}
+		if (!option.delimiter.empty())
+		{
+			stream << ".SetDelimiter(" << EscapeChar(option.delimiter.front()) << ')';
+		}
+	}
+	stream << ");\n\n";
+
+	stream << "// Options part of help rendered by the generator.\n"
+		<< "inline constexpr std::string_view " << help_variable << " =\n";
+	WriteStringLines(stream, args_initializer.GetHelpLayout().GetText(), "\t");
+	stream << ";\n\n";
+
+	stream << "inline SimpleArgsParser::StaticArgsParseResult<" << name << "> " << name
+		<< "::TryParse(const int argc, const char* const* argv)\n{\n"
+		<< "\treturn SimpleArgsParser::TryParseStaticArgs(argc, argv, " << schema_variable << ");\n}\n\n"
+		<< "inline " << name << ' ' << name << "::Parse(const int argc, const char* const* argv)\n{\n"
+		<< "\treturn SimpleArgsParser::ParseStaticArgs(argc, argv, " << schema_variable << ");\n}\n\n"
+		<< "inline std::string " << name << "::GetHelp(std::string_view program_name)\n{\n"
+		<< "\tstd::string result;\n"
+		<< "\tSimpleArgsParser::AppendHelpHeader(result, program_name, " << schema_variable << ".GetDescription(), "
+		<< help_variable << ".size());\n"
+		<< "\tresult.append(" << help_variable << ".data(), " << help_variable << ".size());\n"
+		<< "\treturn result;\n}\n";
+
+	if (!schema.namespace_name.empty())
+	{
+		stream << "\n} // namespace " << schema.namespace_name << '\n';
+	}
+	return stream.str();
+}
+
+} // namespace
+
+} // namespace SimpleArgsParser
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <schema file> <output header>\n";
+		return 1;
+	}
+
+	try
+	{
+		std::ifstream input(argv[1], std::ios::binary);
+		if (!input)
+		{
+			throw SimpleArgsParser::ArgsInitializerException("Can't read schema file.");
+		}
+		std::ostringstream text;
+		text << input.rdbuf();
+
+		const auto schema = SimpleArgsParser::ParseSchema(text.str());
+		const auto header = SimpleArgsParser::Generate(schema, std::filesystem::path(argv[1]).filename().string());
+
+		std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+		output << header;
+		if (!output)
+		{
+			throw SimpleArgsParser::ArgsInitializerException("Can't write " + std::string(argv[2]) + ".");
+		}
+	}
+	catch (const std::exception& exc)
+	{
+		std::cerr << argv[1] << ": " << exc.what() << '\n';
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace SimpleArgsParser
+{
+
+class ArgsInitializer;
+
+// Typed reference to a registered option, gives O(1) access to its value in ArgsContainer.
+template<typename Type>
+class ArgHandle
+{
+
+public:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	ArgHandle() = default;
+
+	size_t GetIndex() const
+	{
+		return index_;
+	}
+
+	bool IsValid() const
+	{
+		return index_ != npos;
+	}
+
+private:
+	friend class ArgsInitializer;
+
+	explicit ArgHandle(size_t index)
+		: index_(index)
+	{}
+
+private:
+	size_t index_ = npos;
+};
+
+} // namespace SimpleArgsParser
@@ -1,25 +1,29 @@
 #pragma once
 
 #include "ArgOptions.h"
+#include "ArgValue.h"
 
-#include <memory>
+#include <functional>
+#include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 namespace SimpleArgsParser
 {
 
-struct IArgValue;
-
 class ArgInfos
 {
 
 public:
 	ArgInfos(
-		std::string full_name,
-		std::string help,
-		std::unique_ptr<IArgValue> arg_value,
-		ArgOptions arg_options,
-		std::string short_name);
+		std::string_view full_name,
+		std::string_view help,
+		ArgValuePtr arg_value,
+		const ArgOptions& arg_options,
+		std::string_view short_name,
+		size_t index,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	ArgInfos(ArgInfos&&) = default;
 
@@ -27,22 +31,28 @@ public:
 
 	const ArgOptions& GetOptions() const;
 
-	const std::string& GetHelp() const;
+	std::string_view GetHelp() const;
+
+	std::string_view GetShortName() const;
 
-	const std::string& GetShortName() const;
+	std::string_view GetFullName() const;
 
-	const std::string& GetFullName() const;
+	// Dense index of the option in registration order.
+	size_t GetIndex() const;
 
 	bool HasValue() const;
 
 	~ArgInfos();
 
 private:
-	std::string full_name_;
-	std::string help_;
-	std::unique_ptr<IArgValue> arg_value_;
+	std::pmr::string full_name_;
+	std::pmr::string help_;
+	ArgValuePtr arg_value_;
 	ArgOptions arg_options_;
-	std::string short_name_;
+	std::pmr::string short_name_;
+	size_t index_;
 };
 
-} // namespace SimpleArgsParser
\ No newline at end of file
+using ArgsInfosMap = std::pmr::map<std::pmr::string, ArgInfos, std::less<>>;
+
+} // namespace SimpleArgsParser
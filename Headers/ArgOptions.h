@@ -1,15 +1,31 @@
 #pragma once
 
+#include <memory_resource>
+#include <string>
+
 namespace SimpleArgsParser
 {
 
 struct ArgOptions
 {
 public:
+	ArgOptions() = default;
+	// Copies names into the memory resource.
+	ArgOptions(const ArgOptions& other, std::pmr::memory_resource* resource);
+
 	ArgOptions& SetRequired();
 
+	// Value is taken from the environment variable if the option isn't set in argv.
+	ArgOptions& SetEnv(std::string name);
+
+	// Value is taken from the config file ("section.key" for keys inside [section])
+	// if the option isn't set in argv or in the environment.
+	ArgOptions& SetConfigKey(std::string key);
+
 public:
 	bool required = false;
+	std::pmr::string env_name;
+	std::pmr::string config_key;
 };
 
-} // namespace SimpleArgsParser
\ No newline at end of file
+} // namespace SimpleArgsParser
@@ -3,80 +3,163 @@
 #include "ArgsParserException.h"
 #include "ArgsParserHelpStruct.h"
 
-#include <stdexcept>
+#include <charconv>
+#include <exception>
+#include <limits>
+#include <new>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
 namespace SimpleArgsParser
 {
 
+enum class ConvertStatus
+{
+	Ok,
+	InvalidValue,
+	OutOfRange
+};
+
+// Wide character types aren't accepted by std::from_chars, their values are
+// parsed as numbers like values of char.
 template<typename Type>
-std::enable_if_t<std::is_integral_v<Type>, Type>
-ParseFromString(const std::string& value, const ArgsParserHelpStruct<Type>)
+constexpr bool is_wide_char_v =
+	std::is_same_v<Type, wchar_t> || std::is_same_v<Type, char16_t> || std::is_same_v<Type, char32_t>;
+
+// Locale independent conversion which never throws and never allocates.
+// The whole value must be consumed, trailing symbols are reported as InvalidValue.
+template<typename Type>
+std::enable_if_t<std::is_arithmetic_v<Type>, ConvertStatus>
+ConvertFromString(std::string_view value, Type& result) noexcept
 {
-	try
+	if constexpr (is_wide_char_v<Type>)
 	{
-		if constexpr (std::is_unsigned<Type>::value)
+		using Integer = std::conditional_t<std::is_signed_v<Type>, long long, unsigned long long>;
+		Integer converted{};
+		const auto status = ConvertFromString(value, converted);
+		if (status != ConvertStatus::Ok)
 		{
-			const auto result = std::stoull(value);
-			if (result > std::numeric_limits<Type>::max())
-			{
-				throw ArgsParserException("Value out of range.");
-			}
-			return static_cast<Type>(result);
+			return status;
 		}
-		else
+		if (converted < static_cast<Integer>(std::numeric_limits<Type>::min())
+			|| converted > static_cast<Integer>(std::numeric_limits<Type>::max()))
 		{
-			const auto result = std::stoll(value);
-			if (result > std::numeric_limits<Type>::max() || result < std::numeric_limits<Type>::min())
-			{
-				throw ArgsParserException("Value out of range.");
-			}
-			return static_cast<Type>(result);
+			return ConvertStatus::OutOfRange;
 		}
+		result = static_cast<Type>(converted);
+		return ConvertStatus::Ok;
 	}
-	catch (const std::invalid_argument& exc)
+	else if constexpr (std::is_same_v<Type, bool>)
 	{
-		throw ArgsParserException(exc.what());
+		if (value == "1" || value == "true")
+		{
+			result = true;
+			return ConvertStatus::Ok;
+		}
+		if (value == "0" || value == "false")
+		{
+			result = false;
+			return ConvertStatus::Ok;
+		}
+		return ConvertStatus::InvalidValue;
 	}
-	catch (const std::out_of_range& exc)
+	else
 	{
-		throw ArgsParserException(exc.what());
+		// std::from_chars doesn't accept explicit plus sign.
+		if (value.size() > 1 && value.front() == '+' && value[1] != '-')
+		{
+			value.remove_prefix(1);
+		}
+
+		const auto* const begin = value.data();
+		const auto* const end = value.data() + value.size();
+		Type converted{};
+		const auto [ptr, error] = std::from_chars(begin, end, converted);
+		if (error == std::errc::result_out_of_range)
+		{
+			return ConvertStatus::OutOfRange;
+		}
+		if (error != std::errc() || ptr != end)
+		{
+			return ConvertStatus::InvalidValue;
+		}
+		result = converted;
+		return ConvertStatus::Ok;
 	}
 }
 
-template<typename Type>
-std::enable_if_t<std::is_floating_point_v<Type>, Type>
-ParseFromString(const std::string& value, const ArgsParserHelpStruct<Type>)
+inline std::string GetConvertErrorMessage(std::string_view value, ConvertStatus status)
+{
+	if (status == ConvertStatus::OutOfRange)
+	{
+		return "Value out of range.";
+	}
+	return "Incorrect value: " + std::string(value) + ".";
+}
+
+inline void ThrowConvertError(std::string_view value, ConvertStatus status)
+{
+	throw ArgsParserException(GetConvertErrorMessage(value, status));
+}
+
+// User converters report errors by exceptions, any of them except std::bad_alloc
+// makes the value incorrect and its message is put to error.
+template<typename Convert>
+ConvertStatus CallUserConverter(std::string_view value, Convert&& convert, std::string& error)
 {
 	try
 	{
-		const auto result = std::stold(value);
-		if (result > std::numeric_limits<Type>::max() || result < std::numeric_limits<Type>::min())
-		{
-			throw ArgsParserException("Value out of range.");
-		}
-		return static_cast<Type>(result);
+		convert();
+		return ConvertStatus::Ok;
+	}
+	catch (const std::bad_alloc&)
+	{
+		throw;
+	}
+	catch (const std::exception& exc)
+	{
+		error = exc.what();
 	}
-	catch (const std::invalid_argument& exc)
+	catch (...)
 	{
-		throw ArgsParserException(exc.what());
+		error = GetConvertErrorMessage(value, ConvertStatus::InvalidValue);
 	}
-	catch (const std::out_of_range& exc)
+	return ConvertStatus::InvalidValue;
+}
+
+template<typename Type>
+std::enable_if_t<std::is_arithmetic_v<Type>, Type>
+ParseFromString(std::string_view value, const ArgsParserHelpStruct<Type>)
+{
+	Type result{};
+	const auto status = ConvertFromString(value, result);
+	if (status != ConvertStatus::Ok)
 	{
-		throw ArgsParserException(exc.what());
+		ThrowConvertError(value, status);
 	}
+	return result;
 }
 
 template<typename Type>
 std::enable_if_t<std::is_arithmetic_v<Type>, std::string>
 ConvertToString(const Type& value)
 {
-	return std::to_string(value);
+	if constexpr (is_wide_char_v<Type>)
+	{
+		using Integer = std::conditional_t<std::is_signed_v<Type>, long long, unsigned long long>;
+		return std::to_string(static_cast<Integer>(value));
+	}
+	else
+	{
+		return std::to_string(value);
+	}
 }
 
-inline std::string ParseFromString(const std::string& value, const ArgsParserHelpStruct<std::string>)
+inline std::string ParseFromString(std::string_view value, const ArgsParserHelpStruct<std::string>)
 {
-	return value;
+	return std::string(value);
 }
 
 inline std::string ConvertToString(const std::string& value)
@@ -84,4 +167,4 @@ inline std::string ConvertToString(const std::string& value)
 	return value;
 }
 
-} // namespace SimpleArgsParser
\ No newline at end of file
+} // namespace SimpleArgsParser
@@ -2,23 +2,119 @@
 
 #include "ArgsParserException.h"
 #include "ArgStringParsers.h"
+#include "ArgsListSplitter.h"
+#include "ArgsValueStore.h"
 
-#include <any>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
 
 namespace SimpleArgsParser
 {
 
 struct IArgValue
 {
-	virtual std::any GetFromString(const std::string& value) const = 0;
-	virtual const std::any& GetDefault() const = 0;
+	// Doesn't throw on incorrect value. Error message of user type converter is put to error.
+	virtual ConvertStatus ParseInto(
+		std::string_view value,
+		ArgsValueStore& store,
+		size_t index,
+		std::string& error) const = 0;
+	virtual void SetDefaultInto(ArgsValueStore& store, size_t index) const = 0;
 	virtual std::string GetStringDefaultValue() const = 0;
 	virtual bool HasDefaultValue() const = 0;
+	// Values of repeated occurrences are appended instead of being skipped.
+	virtual bool IsMultiValued() const = 0;
+
+	// If binding of the store is enabled, values of bound options are
+	// converted straight into the bound variable or the member of the store
+	// bind object instead of the store.
+	virtual bool IsBound() const = 0;
+	// Type of the object of member binding, nullptr otherwise.
+	virtual const std::type_info* GetBoundObjectType() const = 0;
+	// Writes the default to the bound variable or the member of the object.
+	virtual void SetDefaultTo(void* object) const = 0;
 
 	virtual ~IArgValue() = default;
 };
 
+// Destination of a bound option: a variable or a member of the bind object.
+template<typename T>
+class ArgBinding
+{
+
+public:
+	void Bind(T* variable)
+	{
+		variable_ = variable;
+		member_ = nullptr;
+		resolve_ = nullptr;
+		object_type_ = nullptr;
+	}
+
+	template<typename Object>
+	void Bind(T Object::* member)
+	{
+		variable_ = nullptr;
+		// Pointers to data members can be cast to members of another class and back.
+		member_ = reinterpret_cast<AnyMember>(member);
+		resolve_ = &ResolveMember<Object>;
+		object_type_ = &typeid(Object);
+	}
+
+	bool IsBound() const
+	{
+		return variable_ != nullptr || resolve_ != nullptr;
+	}
+
+	const std::type_info* GetObjectType() const
+	{
+		return object_type_;
+	}
+
+	// Returns nullptr if binding of the store isn't enabled.
+	T* Resolve(const ArgsValueStore& store) const
+	{
+		return store.IsBindingEnabled() ? Resolve(store.GetBindObject()) : nullptr;
+	}
+
+	// Returns nullptr if the option isn't bound or is bound to a member and there is no object.
+	T* Resolve(void* object) const
+	{
+		if (resolve_ == nullptr || object == nullptr)
+		{
+			return variable_;
+		}
+		return resolve_(object, member_);
+	}
+
+private:
+	struct AnyObject
+	{};
+
+	using AnyMember = T AnyObject::*;
+
+	template<typename Object>
+	static T* ResolveMember(void* object, AnyMember member)
+	{
+		return &(static_cast<Object*>(object)->*reinterpret_cast<T Object::*>(member));
+	}
+
+private:
+	T* variable_ = nullptr;
+	// Member of the object of the type object_type_.
+	AnyMember member_ = nullptr;
+	T* (*resolve_)(void*, AnyMember) = nullptr;
+	const std::type_info* object_type_ = nullptr;
+};
+
 template<typename T>
 class ArgValue : public IArgValue
 {
@@ -30,27 +126,251 @@ public:
 		return *this;
 	}
 
-	std::any GetFromString(const std::string& value) const override
+	// TryParseArgsInto converts the value into the variable, which must
+	// outlive the parse. ParseArgs and TryParseArgs don't write bound
+	// variables, containers keep their own copy of the value.
+	ArgValue& BindTo(T* variable)
+	{
+		binding_.Bind(variable);
+		return *this;
+	}
+
+	// Value is converted into the member of the object given to TryParseArgsInto.
+	template<typename Object>
+	ArgValue& BindTo(T Object::* member)
 	{
-		return ParseFromString(value, ArgsParserHelpStruct<T>());
+		binding_.Bind(member);
+		return *this;
 	}
 
-	const std::any& GetDefault() const override
+	ConvertStatus ParseInto(
+		std::string_view value,
+		ArgsValueStore& store,
+		size_t index,
+		std::string& error) const override
+	{
+		if (auto* variable = binding_.Resolve(store); variable != nullptr)
+		{
+			const auto status = ConvertInto(value, *variable, error);
+			if (status == ConvertStatus::Ok)
+			{
+				store.SetBound(index);
+			}
+			return status;
+		}
+
+		if constexpr (std::is_arithmetic_v<T>)
+		{
+			T result{};
+			const auto status = ConvertFromString(value, result);
+			if (status == ConvertStatus::Ok)
+			{
+				store.Set<T>(index, result);
+			}
+			return status;
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			store.Emplace<T>(index).assign(value.data(), value.size());
+			return ConvertStatus::Ok;
+		}
+		else
+		{
+			return CallUserConverter(
+				value,
+				[&]() { store.Set<T>(index, ParseFromString(value, ArgsParserHelpStruct<T>())); },
+				error);
+		}
+	}
+
+	void SetDefaultInto(ArgsValueStore& store, size_t index) const override
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			store.Emplace<T>(index) = GetDefault();
+		}
+		else
+		{
+			store.Set<T>(index, GetDefault());
+		}
+	}
+
+	const T& GetDefault() const
 	{
 		if (!HasDefaultValue())
 		{
 			throw ArgsParserException("Value not set.");
 		}
-		return default_value_;
+		return *default_value_;
 	}
 
 	std::string GetStringDefaultValue() const override
+	{
+		return ConvertToString(GetDefault());
+	}
+
+	bool HasDefaultValue() const override
+	{
+		return default_value_.has_value();
+	}
+
+	bool IsMultiValued() const override
+	{
+		return false;
+	}
+
+	bool IsBound() const override
+	{
+		return binding_.IsBound();
+	}
+
+	const std::type_info* GetBoundObjectType() const override
+	{
+		return binding_.GetObjectType();
+	}
+
+	void SetDefaultTo(void* object) const override
+	{
+		if (auto* variable = binding_.Resolve(object); variable != nullptr)
+		{
+			*variable = GetDefault();
+		}
+	}
+
+private:
+	// The variable is assigned only if the value is correct.
+	static ConvertStatus ConvertInto(std::string_view value, T& variable, std::string& error)
+	{
+		if constexpr (std::is_arithmetic_v<T>)
+		{
+			T result{};
+			const auto status = ConvertFromString(value, result);
+			if (status == ConvertStatus::Ok)
+			{
+				variable = result;
+			}
+			return status;
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			variable.assign(value.data(), value.size());
+			return ConvertStatus::Ok;
+		}
+		else
+		{
+			return CallUserConverter(
+				value,
+				[&]() { variable = ParseFromString(value, ArgsParserHelpStruct<T>()); },
+				error);
+		}
+	}
+
+private:
+	std::optional<T> default_value_;
+	ArgBinding<T> binding_;
+};
+
+// List option, accepts both repeated occurrences (--id 1 --id 2) and
+// delimited values (--id 1,2). Values of all occurrences are appended.
+template<typename T>
+class ArgValue<std::vector<T>> : public IArgValue
+{
+
+public:
+	ArgValue& SetDefault(std::vector<T> value)
+	{
+		default_value_ = std::move(value);
+		return *this;
+	}
+
+	ArgValue& SetDelimiter(char delimiter)
+	{
+		delimiter_ = delimiter;
+		return *this;
+	}
+
+	// TryParseArgsInto converts the values into the variable, which must
+	// outlive the parse. Its content is replaced by the values of the first
+	// occurrence. ParseArgs and TryParseArgs don't write bound variables,
+	// containers keep their own copy of the values.
+	ArgValue& BindTo(std::vector<T>* variable)
+	{
+		binding_.Bind(variable);
+		return *this;
+	}
+
+	// Values are converted into the member of the object given to TryParseArgsInto.
+	template<typename Object>
+	ArgValue& BindTo(std::vector<T> Object::* member)
+	{
+		binding_.Bind(member);
+		return *this;
+	}
+
+	ConvertStatus ParseInto(
+		std::string_view value,
+		ArgsValueStore& store,
+		size_t index,
+		std::string& error) const override
+	{
+		if (auto* variable = binding_.Resolve(store); variable != nullptr)
+		{
+			// The variable is changed only if all values are correct.
+			std::vector<T> values;
+			const auto status = ConvertItems(value, values, error);
+			if (status != ConvertStatus::Ok)
+			{
+				return status;
+			}
+			if (!store.Has(index))
+			{
+				*variable = std::move(values);
+			}
+			else
+			{
+				variable->insert(
+					variable->end(),
+					std::make_move_iterator(values.begin()),
+					std::make_move_iterator(values.end()));
+			}
+			store.SetBound(index);
+			return status;
+		}
+
+		auto* values = store.GetMutable<std::vector<T>>(index);
+		if (values == nullptr)
+		{
+			values = &store.Emplace<std::vector<T>>(index);
+		}
+		return ConvertItems(value, *values, error);
+	}
+
+	void SetDefaultInto(ArgsValueStore& store, size_t index) const override
+	{
+		store.Emplace<std::vector<T>>(index) = GetDefault();
+	}
+
+	const std::vector<T>& GetDefault() const
 	{
 		if (!HasDefaultValue())
 		{
 			throw ArgsParserException("Value not set.");
 		}
-		return ConvertToString(std::any_cast<T>(default_value_));
+		return *default_value_;
+	}
+
+	std::string GetStringDefaultValue() const override
+	{
+		std::string result;
+		for (const auto& value : GetDefault())
+		{
+			if (!result.empty())
+			{
+				result += delimiter_;
+			}
+			result += ConvertToString(value);
+		}
+		return result;
 	}
 
 	bool HasDefaultValue() const override
@@ -58,8 +378,122 @@ public:
 		return default_value_.has_value();
 	}
 
+	bool IsMultiValued() const override
+	{
+		return true;
+	}
+
+	bool IsBound() const override
+	{
+		return binding_.IsBound();
+	}
+
+	const std::type_info* GetBoundObjectType() const override
+	{
+		return binding_.GetObjectType();
+	}
+
+	void SetDefaultTo(void* object) const override
+	{
+		if (auto* variable = binding_.Resolve(object); variable != nullptr)
+		{
+			*variable = GetDefault();
+		}
+	}
+
+private:
+	// Appends values of the delimited list, stops on the first incorrect one.
+	ConvertStatus ConvertItems(std::string_view value, std::vector<T>& values, std::string& error) const
+	{
+		values.reserve(values.size() + CountListItems(value, delimiter_));
+
+		auto status = ConvertStatus::Ok;
+		SplitList(
+			value,
+			delimiter_,
+			[&values, &status, &error](std::string_view item)
+			{
+				if constexpr (std::is_arithmetic_v<T>)
+				{
+					T result{};
+					status = ConvertFromString(item, result);
+					if (status != ConvertStatus::Ok)
+					{
+						error = GetConvertErrorMessage(item, status);
+						return false;
+					}
+					values.push_back(result);
+				}
+				else if constexpr (std::is_same_v<T, std::string>)
+				{
+					values.emplace_back(item);
+				}
+				else
+				{
+					status = CallUserConverter(
+						item,
+						[&]() { values.push_back(ParseFromString(item, ArgsParserHelpStruct<T>())); },
+						error);
+					if (status != ConvertStatus::Ok)
+					{
+						return false;
+					}
+				}
+				return true;
+			});
+		return status;
+	}
+
 private:
-	std::any default_value_;
+	std::optional<std::vector<T>> default_value_;
+	char delimiter_ = ',';
+	ArgBinding<std::vector<T>> binding_;
 };
 
+// Destroys IArgValue allocated from the memory resource.
+class ArgValueDeleter
+{
+
+public:
+	ArgValueDeleter() = default;
+
+	ArgValueDeleter(std::pmr::memory_resource* resource, size_t size, size_t alignment)
+		: resource_(resource)
+		, size_(size)
+		, alignment_(alignment)
+	{}
+
+	void operator()(IArgValue* value) const
+	{
+		value->~IArgValue();
+		resource_->deallocate(value, size_, alignment_);
+	}
+
+private:
+	std::pmr::memory_resource* resource_ = nullptr;
+	size_t size_ = 0;
+	size_t alignment_ = 0;
+};
+
+using ArgValuePtr = std::unique_ptr<IArgValue, ArgValueDeleter>;
+
+template<typename T>
+ArgValuePtr MakeArgValue(ArgValue<T> value, std::pmr::memory_resource* resource)
+{
+	constexpr auto size = sizeof(ArgValue<T>);
+	constexpr auto alignment = alignof(ArgValue<T>);
+	void* memory = resource->allocate(size, alignment);
+	try
+	{
+		return ArgValuePtr(
+			new (memory) ArgValue<T>(std::move(value)),
+			ArgValueDeleter(resource, size, alignment));
+	}
+	catch (...)
+	{
+		resource->deallocate(memory, size, alignment);
+		throw;
+	}
+}
+
 } // namespace SimpleArgsParser
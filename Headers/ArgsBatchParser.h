@@ -0,0 +1,32 @@
+#pragma once
+
+#include "ArgsParser.h"
+
+#include <optional>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+struct BatchParseResult
+{
+	bool HasError() const;
+
+	// Set if the command line was parsed successfully.
+	std::optional<ArgsContainer> args;
+	// Parse error otherwise. Exceptions like bad_alloc are reported as
+	// InternalError. The token refers to the command line or the initializer.
+	ArgsParseError error;
+};
+
+// Parses every command line (argv with argv[0] as program name) against the same
+// initializer on a pool of threads_count threads (0 means hardware concurrency).
+// Threads take small chunks of command lines from a shared counter, so threads
+// which got short command lines take more of them. Errors are reported per
+// command line, exceptions never cross threads. Results keep the order of input.
+std::vector<BatchParseResult> ParseArgsBatch(
+	const std::vector<std::vector<const char*>>& command_lines,
+	const ArgsInitializer& argument_initializer,
+	size_t threads_count = 0);
+
+} // namespace SimpleArgsParser
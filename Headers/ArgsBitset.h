@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+// Set of option indexes packed into 64-bit words. Operations on two sets
+// treat words missing in the shorter one as empty.
+class ArgsBitset
+{
+
+public:
+	static constexpr size_t word_bits = 64;
+
+	explicit ArgsBitset(
+		size_t size = 0,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	// Copies are allocated from the resource of the source.
+	ArgsBitset(const ArgsBitset& other);
+	ArgsBitset(const ArgsBitset& other, std::pmr::memory_resource* resource);
+	ArgsBitset(ArgsBitset&& other) noexcept = default;
+	ArgsBitset& operator=(const ArgsBitset& other) = default;
+	ArgsBitset& operator=(ArgsBitset&& other) = default;
+
+	size_t Size() const;
+	// New indexes are unset.
+	void Resize(size_t size);
+
+	void Set(size_t index);
+	bool Test(size_t index) const;
+	// Unsets all indexes.
+	void Clear();
+
+	size_t Count() const;
+	// Size of the union with other.
+	size_t CountOr(const ArgsBitset& other) const;
+	size_t GetWordsCount() const;
+	// Words past the end are empty.
+	uint64_t GetWord(size_t index) const;
+
+	// Calls func(index) in increasing order for indexes which aren't in other,
+	// stops when func returns false.
+	template<typename Func>
+	void ForEachNotIn(const ArgsBitset& other, Func func) const
+	{
+		for (size_t i = 0; i < words_.size(); ++i)
+		{
+			if (!ForEachInWord(i, words_[i] & ~other.GetWord(i), func))
+			{
+				return;
+			}
+		}
+	}
+
+	// Calls func(index) for bits of the word with the index, returns false if func stopped.
+	template<typename Func>
+	static bool ForEachInWord(size_t word_index, uint64_t word, Func func)
+	{
+		while (word != 0)
+		{
+			const auto bit = static_cast<size_t>(__builtin_ctzll(word));
+			if (!func(word_index * word_bits + bit))
+			{
+				return false;
+			}
+			word &= word - 1;
+		}
+		return true;
+	}
+
+private:
+	std::pmr::vector<uint64_t> words_;
+	size_t size_ = 0;
+};
+
+} // namespace SimpleArgsParser
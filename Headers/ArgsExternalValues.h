@@ -0,0 +1,117 @@
+#pragma once
+
+#include "ArgsParseError.h"
+#include "ArgsResponseFiles.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+class ArgsInitializer;
+
+// Calls callback(section, key, value) for every "key = value" line of INI file.
+// Lines starting with '#' or ';' are comments, values may be put in double quotes.
+// Returns number of the incorrect line or 0.
+template<typename Callback>
+size_t ParseConfigFile(std::string_view text, Callback&& on_value)
+{
+	const auto trim = [](std::string_view value)
+	{
+		const auto is_space = [](char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		};
+		while (!value.empty() && is_space(value.front()))
+		{
+			value.remove_prefix(1);
+		}
+		while (!value.empty() && is_space(value.back()))
+		{
+			value.remove_suffix(1);
+		}
+		return value;
+	};
+
+	std::string_view section;
+	size_t line_number = 0;
+	while (!text.empty())
+	{
+		++line_number;
+		const auto line_end = text.find('\n');
+		const auto line = trim(text.substr(0, line_end));
+		text.remove_prefix(line_end == std::string_view::npos ? text.size() : line_end + 1);
+
+		if (line.empty() || line.front() == '#' || line.front() == ';')
+		{
+			continue;
+		}
+		if (line.front() == '[')
+		{
+			if (line.back() != ']')
+			{
+				return line_number;
+			}
+			section = trim(line.substr(1, line.size() - 2));
+			continue;
+		}
+
+		const auto separator = line.find('=');
+		if (separator == std::string_view::npos)
+		{
+			return line_number;
+		}
+		const auto key = trim(line.substr(0, separator));
+		auto value = trim(line.substr(separator + 1));
+		if (key.empty())
+		{
+			return line_number;
+		}
+		if (value.size() > 1 && value.front() == '"' && value.back() == '"')
+		{
+			value = value.substr(1, value.size() - 2);
+		}
+		on_value(section, key, value);
+	}
+	return 0;
+}
+
+// Snapshot of values of options taken from the environment and from the
+// config file, addressed by option index. Environment values take precedence
+// over file ones. Values refer to the copy of environment values and to the
+// mapped file, which are kept until destruction.
+class ArgsExternalValues
+{
+
+public:
+	ArgsExternalValues(
+		size_t options_count,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	// Environment is scanned once, names are resolved by the initializer lookup table.
+	// Error token refers to the config file path of the initializer.
+	ArgsParseError Read(const ArgsInitializer& args_initializer);
+	// Error of the last Read.
+	const ArgsParseError& GetError() const;
+
+	bool Has(size_t index) const;
+	std::string_view Get(size_t index) const;
+
+private:
+	ArgsParseError ReadConfigFile(const ArgsInitializer& args_initializer);
+	void ReadEnvironment(const ArgsInitializer& args_initializer);
+
+private:
+	MappedFile config_file_;
+	// Strings of environ can be freed by setenv and unsetenv, so values are copied.
+	std::pmr::string environment_values_;
+	// Value with null data isn't set.
+	std::pmr::vector<std::string_view> values_;
+	ArgsParseError error_;
+};
+
+} // namespace SimpleArgsParser
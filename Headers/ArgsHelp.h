@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ArgInfos.h"
+
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace SimpleArgsParser
+{
+
+class ArgsInitializer;
+
+// Option line of help, names are written with '-'.
+struct ArgHelpRow
+{
+	std::string_view full_name;
+	std::string_view short_name;
+	std::string_view help;
+	std::string_view default_value;
+	bool has_value = false;
+	bool has_default = false;
+};
+
+// Options part of help. It doesn't depend on the program name, so a frozen
+// initializer renders it only once and help is written as a single block.
+class ArgsHelpLayout
+{
+
+public:
+	explicit ArgsHelpLayout(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	void Build(
+		const ArgsInfosMap& infos,
+		size_t max_size_arg_help_desc,
+		size_t max_size_arg_help_info);
+
+	bool Empty() const;
+
+	std::string_view GetText() const;
+
+	// Wraps help of every option in one pass without intermediate strings.
+	static void Write(
+		std::ostream& stream,
+		const ArgsInfosMap& infos,
+		size_t max_size_arg_help_desc,
+		size_t max_size_arg_help_info);
+
+	static void Write(
+		std::string& buffer,
+		const ArgsInfosMap& infos,
+		size_t max_size_arg_help_desc,
+		size_t max_size_arg_help_info);
+
+private:
+	std::pmr::string text_;
+	bool built_ = false;
+};
+
+void WriteHelp(
+	std::ostream& stream,
+	std::string_view program_name,
+	const ArgsInitializer& args_infos);
+
+void AppendHelp(
+	std::string& buffer,
+	std::string_view program_name,
+	const ArgsInitializer& args_infos);
+
+std::string GetHelpString(
+	std::string_view program_name,
+	const ArgsInitializer& args_infos);
+
+// "Usage" and description lines, options_size is reserved for the options part.
+void AppendHelpHeader(
+	std::string& buffer,
+	std::string_view program_name,
+	std::string_view description,
+	size_t options_size = 0);
+
+// Appends one option in the layout of ArgsHelpLayout, for options which are
+// not kept in an initializer.
+void AppendOptionHelp(
+	std::string& buffer,
+	const ArgHelpRow& row,
+	size_t max_size_arg_help_desc,
+	size_t max_size_arg_help_info);
+
+} // namespace SimpleArgsParser
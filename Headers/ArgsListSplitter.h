@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace SimpleArgsParser
+{
+
+namespace ListSplitterDetails
+{
+
+#if defined(__SSE2__)
+// Bit i is set if pos[i] is the delimiter.
+inline unsigned FindDelimiters16(const char* pos, __m128i pattern)
+{
+	const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+	return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+}
+#endif
+
+} // namespace ListSplitterDetails
+
+// Number of items of the delimited list, empty value has no items.
+inline size_t CountListItems(std::string_view value, char delimiter)
+{
+	if (value.empty())
+	{
+		return 0;
+	}
+
+	const char* pos = value.data();
+	const char* const end = value.data() + value.size();
+	size_t count = 1;
+#if defined(__SSE2__)
+	const auto pattern = _mm_set1_epi8(delimiter);
+	for (; end - pos >= 16; pos += 16)
+	{
+		count += static_cast<size_t>(__builtin_popcount(ListSplitterDetails::FindDelimiters16(pos, pattern)));
+	}
+#endif
+	for (; pos != end; ++pos)
+	{
+		count += *pos == delimiter ? 1 : 0;
+	}
+	return count;
+}
+
+// Calls on_item(std::string_view) for every item of the delimited list, stops
+// if it returns false. Delimiters are searched 16 symbols at a time with SSE2.
+// Returns false if splitting was stopped.
+template<typename Callback>
+bool SplitList(std::string_view value, char delimiter, Callback&& on_item)
+{
+	if (value.empty())
+	{
+		return true;
+	}
+
+	const char* item_begin = value.data();
+	const char* pos = value.data();
+	const char* const end = value.data() + value.size();
+#if defined(__SSE2__)
+	const auto pattern = _mm_set1_epi8(delimiter);
+	for (; end - pos >= 16; pos += 16)
+	{
+		for (auto mask = ListSplitterDetails::FindDelimiters16(pos, pattern); mask != 0; mask &= mask - 1)
+		{
+			const char* const delimiter_pos = pos + __builtin_ctz(mask);
+			if (!on_item(std::string_view(item_begin, static_cast<size_t>(delimiter_pos - item_begin))))
+			{
+				return false;
+			}
+			item_begin = delimiter_pos + 1;
+		}
+	}
+#endif
+	for (; pos != end; ++pos)
+	{
+		if (*pos == delimiter)
+		{
+			if (!on_item(std::string_view(item_begin, static_cast<size_t>(pos - item_begin))))
+			{
+				return false;
+			}
+			item_begin = pos + 1;
+		}
+	}
+	return on_item(std::string_view(item_begin, static_cast<size_t>(end - item_begin)));
+}
+
+} // namespace SimpleArgsParser
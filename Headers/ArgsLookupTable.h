@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+// Immutable open-addressing table which maps option names (full and short)
+// to dense option indexes. Names are not copied, so they must outlive the table.
+class ArgsLookupTable
+{
+
+public:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	explicit ArgsLookupTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	void Build(const std::pmr::vector<std::pair<std::string_view, size_t>>& names);
+
+	size_t Find(std::string_view name) const;
+
+	bool Empty() const;
+
+private:
+	struct Slot
+	{
+		std::string_view name;
+		uint64_t hash = 0;
+		size_t index = npos;
+	};
+
+	static uint64_t Hash(std::string_view name);
+
+private:
+	std::pmr::vector<Slot> slots_;
+	size_t mask_ = 0;
+};
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+// Immutable radix trie over option names. Nodes are kept in one array, children
+// of a node are adjacent and edge labels are slices of one buffer. Names are
+// not copied, so they must outlive the trie.
+class ArgsNameTrie
+{
+
+public:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+	static constexpr size_t ambiguous = npos - 1;
+
+	explicit ArgsNameTrie(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	void Build(const std::pmr::vector<std::pair<std::string_view, size_t>>& names);
+
+	size_t Find(std::string_view name) const;
+
+	// Index of the only name which starts with the prefix, npos if there is no
+	// such name and ambiguous if there are several.
+	size_t FindByPrefix(std::string_view prefix) const;
+
+	// Names which start with the prefix in alphabetical order.
+	std::vector<std::string_view> CollectByPrefix(std::string_view prefix, size_t max_count) const;
+
+	// Names within max_distance edits (Levenshtein) of the name, nearest first.
+	// Subtrees which can't get closer than max_distance are skipped.
+	std::vector<std::string_view> FindSimilar(std::string_view name, size_t max_distance, size_t max_count) const;
+
+private:
+	struct Node
+	{
+		uint32_t label_begin = 0;
+		uint32_t label_size = 0;
+		uint32_t children_begin = 0;
+		uint32_t children_count = 0;
+		// Position in names_ of the name which ends in the node or npos.
+		size_t name = npos;
+		// Position of the only name of the subtree or ambiguous.
+		size_t subtree_name = npos;
+	};
+
+	using NamesIterator = std::pmr::vector<std::pair<std::string_view, size_t>>::const_iterator;
+
+	void BuildNode(size_t node, NamesIterator begin, NamesIterator end, size_t depth);
+
+	// Returns node whose subtree contains all names starting with the prefix or npos.
+	size_t FindPrefixNode(std::string_view prefix) const;
+
+	void Collect(size_t node, size_t max_count, std::vector<std::string_view>& result) const;
+
+	std::string_view GetLabel(const Node& node) const;
+
+private:
+	// Sorted names with option indexes.
+	std::pmr::vector<std::pair<std::string_view, size_t>> names_;
+	std::pmr::vector<Node> nodes_;
+	std::pmr::vector<char> labels_;
+	size_t max_name_size_ = 0;
+};
+
+} // namespace SimpleArgsParser
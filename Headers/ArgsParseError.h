@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+class ArgsInitializer;
+
+enum class ArgsErrorCode
+{
+	None,
+	IncorrectArgc,
+	IncorrectArgv,
+	UnknownParam,
+	AmbiguousParam,
+	MissingParamValue,
+	IncorrectValue,
+	ValueOutOfRange,
+	RequiredParamNotSet,
+	ResponseFileNotRead,
+	RecursiveResponseFile,
+	ResponseFilesTooDeep,
+	IncorrectResponseFile,
+	ConfigFileNotRead,
+	IncorrectConfigFile,
+	UnknownSubcommand,
+	ConflictingParams,
+	GroupParamNotSet,
+	DependentParamNotSet,
+	BindObjectTypeMismatch,
+	// Parse was stopped by an exception like bad_alloc, its message is in the details.
+	InternalError
+};
+
+// Describes why parse failed. The message is built only on request, the token
+// refers to argv (or to the option name owned by the initializer or the
+// schema), so the message must be built while they are alive.
+class ArgsParseError
+{
+
+public:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	ArgsParseError() = default;
+
+	ArgsParseError(
+		ArgsErrorCode code,
+		size_t argv_index = npos,
+		std::string_view token = {},
+		std::string details = {});
+
+	ArgsErrorCode GetCode() const;
+
+	// Index of the offending argv element or npos if the error isn't related to one.
+	// Tokens of response files are counted as if they were put into argv.
+	size_t GetArgvIndex() const;
+
+	std::string_view GetToken() const;
+
+	std::string GetMessage() const;
+
+	// Names of similar options for UnknownParam and options starting with
+	// the token for AmbiguousParam, computed on request.
+	std::vector<std::string_view> GetSuggestions(size_t max_count = 3) const;
+
+	// Initializer to search suggestions in, it must outlive the error.
+	void SetInitializer(const ArgsInitializer& initializer);
+
+	// Copies the token, so the error doesn't refer to the parsed input any more.
+	void DetachToken();
+
+	// Returns the full option name of the index of the schema.
+	using ParamNameResolver = std::string_view (*)(const void* schema, size_t index);
+
+	// Full names of the options of RequiredParamNotSet (all missing ones),
+	// ConflictingParams (set ones of the group), GroupParamNotSet (the group)
+	// and DependentParamNotSet (the set option, then its missing dependencies).
+	// The token is the first of them.
+	std::vector<std::string> GetParams() const;
+	const std::vector<size_t>& GetParamIndexes() const;
+
+	// Only option indexes are kept, names are resolved when they are requested,
+	// so the schema must outlive the error. Names are prefixed with name_prefix,
+	// which must be a literal.
+	void SetParams(
+		std::vector<size_t> indexes,
+		const void* schema,
+		ParamNameResolver resolver,
+		std::string_view name_prefix = {});
+
+private:
+	std::string GetParamName(size_t index) const;
+	// Params from first joined with ", ".
+	std::string JoinParams(size_t first) const;
+
+private:
+	ArgsErrorCode code_ = ArgsErrorCode::None;
+	size_t argv_index_ = npos;
+	std::string_view token_;
+	// Shared, so copies of the error keep token valid.
+	std::shared_ptr<const std::string> token_storage_;
+	const ArgsInitializer* initializer_ = nullptr;
+	std::shared_ptr<const std::vector<size_t>> param_indexes_;
+	const void* params_schema_ = nullptr;
+	ParamNameResolver param_name_resolver_ = nullptr;
+	std::string_view param_name_prefix_;
+	// Message of user value converter or of InternalError, empty otherwise.
+	std::string details_;
+};
+
+} // namespace SimpleArgsParser
@@ -1,39 +1,90 @@
 #pragma once
 
+#include "ArgHandle.h"
 #include "ArgInfos.h"
 #include "ArgOptions.h"
+#include "ArgsBitset.h"
+#include "ArgsHelp.h"
+#include "ArgsLookupTable.h"
+#include "ArgsNameTrie.h"
 #include "ArgValue.h"
+#include "ArgsParseError.h"
 #include "ArgsParserException.h"
 #include "ArgsParserHelpStruct.h"
+#include "ArgsValueStore.h"
 
-#include <any>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
 
 namespace SimpleArgsParser
 {
 
+// When supplied option values are converted from strings. Defaults are
+// converted once by the initializer and aren't copied into containers.
+enum class ArgsConversion
+{
+	// On parse, so incorrect values are reported by parse.
+	Eager,
+	// On the first read, so parse cost depends on options read rather than on
+	// options supplied. Incorrect values are reported by GetValue, argv must
+	// outlive the container. List options are still converted on parse.
+	Lazy
+};
+
+class ArgsExternalValues;
+
+// Const member functions don't modify any state except the snapshot of external
+// values, which is built under a lock, so a fully built (preferably frozen)
+// initializer can be shared between concurrent ParseArgs calls.
 class ArgsInitializer
 {
 
 public:
+	// Options are allocated from the memory resource, it must outlive the initializer.
 	explicit ArgsInitializer(
-		std::string description = "",
+		std::string_view description = "",
 		size_t max_size_arg_help_desc = 40,
-		size_t max_size_arg_help_info = 40);
+		size_t max_size_arg_help_info = 40,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	template<typename Type>
+	ArgsInitializer& operator()(
+		std::string option_name,
+		std::string help,
+		ArgValue<Type> value,
+		ArgOptions arg_options = ArgOptions())
+	{
+		AddArg(
+			std::move(option_name),
+			std::move(help),
+			MakeArgValue(std::move(value), resource_),
+			std::move(arg_options));
+		return *this;
+	}
 
+	// Same as above, also returns typed handle of the registered option.
 	template<typename Type>
 	ArgsInitializer& operator()(
 		std::string option_name,
 		std::string help,
 		ArgValue<Type> value,
+		ArgHandle<Type>& handle,
 		ArgOptions arg_options = ArgOptions())
 	{
 		AddArg(
 			std::move(option_name),
 			std::move(help),
-			std::make_unique<ArgValue<Type>>(std::move(value)),
+			MakeArgValue(std::move(value), resource_),
 			std::move(arg_options));
+		handle = ArgHandle<Type>(GetArgsCount() - 1);
 		return *this;
 	}
 
@@ -42,78 +93,429 @@ public:
 		std::string help,
 		ArgOptions arg_options = ArgOptions());
 
-	const ArgInfos& GetArgInfos(std::string value) const;
-	const std::map<std::string, ArgInfos>& GetArgsInfos() const;
-	const std::string& GetDescription() const;
+	// Builds the immutable lookup table used to resolve option names.
+	// No options can be added after the initializer is frozen.
+	void Freeze();
+	bool IsFrozen() const;
+
+	// "@path" arguments are replaced with whitespace separated tokens of the file.
+	// Disabled by default, because option values can start with '@'.
+	ArgsInitializer& EnableResponseFiles(bool enable = true);
+	bool IsResponseFilesEnabled() const;
+
+	// Options bound with ArgOptions::SetConfigKey are read from this file.
+	// Missing file is ignored.
+	ArgsInitializer& SetConfigFile(std::string_view path);
+	std::string_view GetConfigFile() const;
+
+	// A frozen initializer reads the environment and the config file once, on
+	// the first parse, and parses look values up in this snapshot, so later
+	// changes are seen only after RefreshExternalValues. Not frozen one reads
+	// them on every parse. Values are allocated from the memory resource of
+	// the initializer if it's frozen and from the resource otherwise.
+	std::shared_ptr<const ArgsExternalValues> GetExternalValues(std::pmr::memory_resource* resource) const;
+	// The snapshot is read again by the next parse. Can be called concurrently
+	// with parses, which keep using the old snapshot.
+	void RefreshExternalValues();
+
+	bool HasEnvOptions() const;
+	bool HasConfigOptions() const;
+	// Return index of the bound option or npos.
+	size_t FindEnvOption(std::string_view name) const;
+	size_t FindConfigOption(std::string_view key) const;
+
+	const ArgInfos& GetArgInfos(std::string_view value) const;
+	const ArgInfos* FindArgInfos(std::string_view value) const;
+
+	// Eager by default.
+	ArgsInitializer& SetConversion(ArgsConversion conversion);
+	ArgsConversion GetConversion() const;
+
+	// Group constraints are compiled into bitmasks of option indexes and are
+	// checked after parse against options set in argv, the environment or the
+	// config file, defaults don't count. Options are named as on the command
+	// line ("--input" or "-i") and must be added before the group.
+	// Not more than one option of the group can be set.
+	ArgsInitializer& AddExclusiveGroup(const std::vector<std::string_view>& names);
+	// At least one option of the group must be set.
+	ArgsInitializer& AddAtLeastOneGroup(const std::vector<std::string_view>& names);
+	// If the option is set, all required options must be set too.
+	ArgsInitializer& AddRequires(std::string_view name, const std::vector<std::string_view>& required_names);
+	// Returns the first violated constraint in the order of adding.
+	ArgsParseError CheckGroups(const ArgsBitset& set_options) const;
+
+	// Long options can be abbreviated on the command line (--verb for --verbose)
+	// while the abbreviation is unambiguous. Disabled by default.
+	ArgsInitializer& EnableAbbreviations(bool enable = true);
+	bool IsAbbreviationsEnabled() const;
+	// Finds the only full option name starting with the prefix.
+	const ArgInfos* FindArgInfosByPrefix(std::string_view prefix, bool& ambiguous) const;
+	std::vector<std::string_view> FindNamesByPrefix(std::string_view prefix, size_t max_count) const;
+	// Nearest option names by edit distance. A frozen initializer searches
+	// its name trie, otherwise all names are compared.
+	std::vector<std::string_view> FindSimilarNames(std::string_view name, size_t max_count) const;
+	const ArgInfos& GetArgInfosByIndex(size_t index) const;
+	size_t GetArgsCount() const;
+	const ArgsInfosMap& GetArgsInfos() const;
+	std::string_view GetDescription() const;
 	size_t GetMaxSizeArgHelpDesc() const;
 	size_t GetMaxSizeArgHelpInfo() const;
+	// Empty until the initializer is frozen.
+	const ArgsHelpLayout& GetHelpLayout() const;
+	// Default values addressed by option index, containers refer to them.
+	const ArgsValueStore& GetDefaults() const;
+	const ArgsBitset& GetRequiredOptions() const;
+	// Options bound to environment variables or config keys.
+	const ArgsBitset& GetExternalOptions() const;
+	// Options bound to variables or members by ArgValue::BindTo.
+	const ArgsBitset& GetBoundOptions() const;
+	// Type of the object whose members are bound, nullptr if there are none.
+	const std::type_info* GetBoundObjectType() const;
+	std::pmr::memory_resource* GetMemoryResource() const;
 
 private:
+	enum class GroupType
+	{
+		Exclusive,
+		AtLeastOne,
+		Requires
+	};
+
+	// Nonzero words of the group bitset with their indexes, so a check costs
+	// a word operation per word of the group whatever the number of options.
+	struct OptionsGroup
+	{
+		GroupType type;
+		std::pmr::vector<std::pair<size_t, uint64_t>> words;
+		// The dependent option of Requires.
+		size_t option_index = 0;
+	};
+
+	struct ExternalValuesCache
+	{
+		std::mutex mutex;
+		std::shared_ptr<const ArgsExternalValues> values;
+	};
+
+	void AddGroup(GroupType type, std::string_view name, const std::vector<std::string_view>& names);
+	std::shared_ptr<const ArgsExternalValues> ReadExternalValues(std::pmr::memory_resource* resource) const;
+
 	void AddArg(
 		std::string option_name,
 		std::string help,
-		std::unique_ptr<IArgValue> arg_value,
+		ArgValuePtr arg_value,
 		ArgOptions arg_options);
 
 private:
-	std::map<std::string, ArgInfos> args_infos_;
-	std::map<std::string, std::string> short_to_full_name_;
-	std::string description_;
+	std::pmr::memory_resource* resource_;
+	ArgsInfosMap args_infos_;
+	std::pmr::map<std::pmr::string, std::pmr::string, std::less<>> short_to_full_name_;
+	std::pmr::vector<const ArgInfos*> indexed_args_infos_;
+	std::pmr::map<std::pmr::string, size_t, std::less<>> env_name_to_index_;
+	std::pmr::map<std::pmr::string, size_t, std::less<>> config_key_to_index_;
+	ArgsLookupTable lookup_table_;
+	ArgsNameTrie name_trie_;
+	ArgsLookupTable env_table_;
+	ArgsLookupTable config_table_;
+	ArgsHelpLayout help_layout_;
+	ArgsValueStore defaults_;
+	ArgsBitset required_options_;
+	ArgsBitset external_options_;
+	ArgsBitset bound_options_;
+	const std::type_info* bound_object_type_ = nullptr;
+	std::pmr::vector<OptionsGroup> groups_;
+	bool frozen_ = false;
+	bool response_files_enabled_ = false;
+	bool abbreviations_enabled_ = false;
+	ArgsConversion conversion_ = ArgsConversion::Eager;
+	std::pmr::string config_file_;
+	// Created by Freeze if options are bound to the environment or the config file.
+	std::unique_ptr<ExternalValuesCache> external_values_;
+	std::pmr::string description_;
 	size_t max_size_arg_help_desc_;
 	size_t max_size_arg_help_info_;
 };
 
+// Values are stored in slots addressed by option index. Keeps a reference to
+// the initializer (to resolve names, read defaults and render help), so the
+// container must not outlive it. Options which aren't set take the default of
+// the initializer, so they cost nothing per container.
+// Raw values of lazy conversion are converted on the first read, which is
+// thread-safe, so a container can be read concurrently.
 class ArgsContainer
 {
 
 public:
 	ArgsContainer(
-		std::map<std::string, std::any> args,
-		std::map<std::string, std::string> short_to_full_name);
+		ArgsValueStore values,
+		std::string_view help,
+		const ArgsInitializer& args_initializer,
+		std::string_view program_name,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	ArgsContainer(const ArgsContainer& other);
+	ArgsContainer(ArgsContainer&& other) noexcept = default;
+	ArgsContainer& operator=(const ArgsContainer& other);
+	ArgsContainer& operator=(ArgsContainer&& other) = default;
 
-	bool Exist(const std::string& key) const;
+	bool Exist(std::string_view key) const;
 
 	template<typename Type>
-	Type GetValue(std::string key) const
+	Type GetValue(std::string_view key) const
 	{
-		if (key.size() <= 1)
+		const auto index = ResolveIndex(key);
+		if (index == help_index)
 		{
-			throw ArgsParserException("Value with key " + key + " not set.");
+			if constexpr (std::is_same_v<Type, std::string>)
+			{
+				return GetHelp();
+			}
+			else
+			{
+				ThrowValueError(ValueStatus::BadType, key, index);
+			}
 		}
-		if (key.size() == 2 || key[1] != '-')
+		const Type* value = nullptr;
+		const auto status = FindValue(index, value);
+		if (status != ValueStatus::Ok)
 		{
-			const auto it = short_to_full_name_.find(key);
-			if (it == short_to_full_name_.cend())
+			ThrowValueError(status, key, index);
+		}
+		return *value;
+	}
+
+	// Non-throwing version of GetValue, returns false if the value can't be got.
+	template<typename Type>
+	bool TryGetValue(std::string_view key, Type& value) const
+	{
+		const auto index = ResolveIndex(key);
+		if (index == help_index)
+		{
+			if constexpr (std::is_same_v<Type, std::string>)
 			{
-				throw ArgsParserException("Value with key " + key + " not set.");
+				value = GetHelp();
+				return true;
 			}
-			key = it->second;
+			return false;
 		}
-		const auto it = args_.find(key);
-		if (it == args_.cend())
+		const Type* result = nullptr;
+		if (FindValue(index, result) != ValueStatus::Ok)
 		{
-			throw ArgsParserException("Value not set.");
+			return false;
 		}
-		try
+		value = *result;
+		return true;
+	}
+
+	template<typename Type>
+	const Type& operator[](const ArgHandle<Type>& handle) const
+	{
+		const Type* value = nullptr;
+		const auto status = FindValue(handle.GetIndex(), value);
+		if (status != ValueStatus::Ok)
 		{
-			return std::any_cast<Type>(it->second);
+			ThrowValueError(status, {}, handle.GetIndex());
 		}
-		catch (const std::bad_any_cast& exc)
+		return *value;
+	}
+
+	size_t Count() const;
+
+	std::string GetHelp() const;
+	void WriteHelp(std::ostream& stream) const;
+
+private:
+	enum class ValueStatus
+	{
+		Ok,
+		UnknownKey,
+		NotSet,
+		BadType,
+		IncorrectValue
+	};
+
+	static constexpr size_t help_index = ArgsLookupTable::npos - 1;
+
+	// Returns help_index for help option and npos if the key is unknown.
+	size_t ResolveIndex(std::string_view key) const;
+
+	template<typename Type>
+	ValueStatus FindValue(size_t index, const Type*& value) const
+	{
+		if (index >= values_.Size())
+		{
+			return ValueStatus::UnknownKey;
+		}
+		if (lazy_values_ != nullptr && !ConvertRawValue(index))
 		{
-			throw ArgsParserException(exc.what());
+			return ValueStatus::IncorrectValue;
 		}
+		if (values_.Has(index))
+		{
+			value = values_.Get<Type>(index);
+		}
+		else if (defaults_ != nullptr && index < defaults_->Size() && defaults_->Has(index))
+		{
+			value = defaults_->Get<Type>(index);
+		}
+		else
+		{
+			return ValueStatus::NotSet;
+		}
+		return value == nullptr ? ValueStatus::BadType : ValueStatus::Ok;
 	}
 
-	size_t Count() const;
+	// Empty key means the value was requested by handle.
+	[[noreturn]] void ThrowValueError(ValueStatus status, std::string_view key, size_t index) const;
+
+	// Returns false if the raw value is incorrect, it's kept raw then.
+	bool ConvertRawValue(size_t index) const;
+	// Marks raw values of the store as pending, does nothing for eager conversion.
+	void ResetLazyValues();
+	// Set values and defaults of the others.
+	size_t CountValues() const;
+	// Raw values may be being converted by other threads.
+	ArgsValueStore CopyValues() const;
+
+	friend class ArgsParseContext;
+
+private:
+	struct LazyValues
+	{
+		std::mutex mutex;
+		std::unique_ptr<std::atomic<bool>[]> pending;
+		size_t size = 0;
+	};
+
+	// Raw values are converted in place on the first read.
+	mutable ArgsValueStore values_;
+	std::unique_ptr<LazyValues> lazy_values_;
+	std::pmr::string help_;
+	const ArgsInitializer* args_initializer_;
+	// Defaults of the initializer, null for the empty container of ArgsParseContext.
+	const ArgsValueStore* defaults_;
+	std::pmr::string program_name_;
+	size_t count_ = 0;
+};
+
+// Result of TryParseArgs: either parsed arguments or the parse error.
+class ArgsParseResult
+{
+
+public:
+	ArgsParseResult(ArgsContainer args);
+	ArgsParseResult(ArgsParseError error);
+
+	bool HasValue() const;
+	explicit operator bool() const;
+
+	const ArgsContainer& GetValue() const&;
+	ArgsContainer&& GetValue() &&;
+
+	const ArgsParseError& GetError() const;
 
 private:
-	const std::map<std::string, std::any> args_;
-	const std::map<std::string, std::string> short_to_full_name_;
+	std::optional<ArgsContainer> args_;
+	ArgsParseError error_;
 };
 
+// Doesn't throw on incorrect input, errors are returned in the result.
+// Exceptions of user converters, except std::bad_alloc, are reported as incorrect values.
+ArgsParseResult TryParseArgs(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// The container is allocated from the memory resource, it must outlive the container.
+// Throws ArgsParserException with the message of TryParseArgs error.
 ArgsContainer ParseArgs(
 	const int argc,
 	const char* const* argv,
-	const ArgsInitializer& argument_initializer);
+	const ArgsInitializer& argument_initializer,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Parses options up to the first positional argument, a token which is neither
+// an option nor a value of an option, and stores its index (argc if there is
+// none). Used to parse global options before a subcommand name. Response
+// files aren't expanded, so the index always refers to argv.
+ArgsParseResult TryParseArgsPrefix(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	size_t& positional_index,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Parses argv without a container: values of options bound by
+// ArgValue::BindTo are converted straight into their variables and the
+// members of the object, defaults of the bound options which aren't set are
+// written there too. Values of the options which aren't bound are checked
+// and dropped. Help request is reported by help_requested, the help string
+// is got by GetHelpString. Returns BindObjectTypeMismatch error if the object
+// isn't of the type of the bound members.
+// Values are written as their tokens are parsed, so on error the options
+// parsed before the failing token are already written, while defaults aren't.
+// Parse into a copy of the object to keep it unchanged on error.
+ArgsParseError TryParseArgsInto(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	void* object,
+	const std::type_info& object_type,
+	bool& help_requested,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+template<typename Object>
+ArgsParseError TryParseArgsInto(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	Object& object,
+	bool& help_requested,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+{
+	return TryParseArgsInto(
+		argc,
+		argv,
+		argument_initializer,
+		static_cast<void*>(&object),
+		typeid(Object),
+		help_requested,
+		resource);
+}
+
+// Same for options bound to variables only.
+ArgsParseError TryParseArgsInto(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	bool& help_requested,
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// Container which is refilled by every parse, for programs which parse many
+// command lines against one initializer. Value slots, string and list values
+// and help keep their capacity, so a command line of flags and numbers is
+// parsed without allocations once the context has seen it.
+class ArgsParseContext
+{
+
+public:
+	explicit ArgsParseContext(
+		const ArgsInitializer& argument_initializer,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	// Replaces arguments of the previous parse, the container is empty on error.
+	ArgsParseError TryParse(const int argc, const char* const* argv);
+
+	// Throws ArgsParserException with the message of TryParse error.
+	// The container is valid until the next parse.
+	const ArgsContainer& Parse(const int argc, const char* const* argv);
+
+	const ArgsContainer& GetArgs() const;
+
+private:
+	ArgsContainer args_;
+	std::pmr::memory_resource* resource_;
+};
 
 } // namespace SimpleArgsParser
\ No newline at end of file
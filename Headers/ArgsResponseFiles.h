@@ -0,0 +1,173 @@
+#pragma once
+
+#include "ArgsParseError.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+// Private writable mapping of a file, changes are never written to the file.
+class MappedFile
+{
+
+public:
+	MappedFile() = default;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	// Returns false if the file can't be opened or mapped.
+	bool Open(const char* path);
+
+	char* GetData() const;
+	size_t GetSize() const;
+
+private:
+	void Close();
+
+private:
+	char* data_ = nullptr;
+	size_t size_ = 0;
+};
+
+namespace ResponseFileDetails
+{
+
+enum SymbolClass : unsigned char
+{
+	Plain,
+	Space,
+	Special
+};
+
+struct SymbolClasses
+{
+	constexpr SymbolClasses()
+		: values()
+	{
+		for (const char symbol : { ' ', '\n', '\t', '\r', '\v', '\f' })
+		{
+			values[static_cast<unsigned char>(symbol)] = Space;
+		}
+		for (const char symbol : { '"', '\'', '\\' })
+		{
+			values[static_cast<unsigned char>(symbol)] = Special;
+		}
+	}
+
+	unsigned char values[256];
+};
+
+inline constexpr SymbolClasses symbol_classes;
+
+inline unsigned char GetSymbolClass(char symbol)
+{
+	return symbol_classes.values[static_cast<unsigned char>(symbol)];
+}
+
+} // namespace ResponseFileDetails
+
+// Splits response file on whitespace and unescapes tokens in place.
+// Quotes group symbols into one token, backslash escapes the next symbol
+// (except inside single quotes). Memory is written only when a token is
+// unescaped, so plain files aren't copied by the kernel.
+// Returns false on unterminated quote.
+template<typename Callback>
+bool TokenizeResponseFile(char* begin, char* end, Callback&& on_token)
+{
+	using namespace ResponseFileDetails;
+
+	char* read = begin;
+	while (true)
+	{
+		while (read != end && GetSymbolClass(*read) == Space)
+		{
+			++read;
+		}
+		if (read == end)
+		{
+			return true;
+		}
+
+		char* const token_begin = read;
+		// Fast path: nothing to unescape, symbols stay where they are.
+		while (read != end && GetSymbolClass(*read) == Plain)
+		{
+			++read;
+		}
+		char* write = read;
+
+		while (read != end && GetSymbolClass(*read) != Space)
+		{
+			const char symbol = *read;
+			if (symbol == '"' || symbol == '\'')
+			{
+				++read;
+				while (read != end && *read != symbol)
+				{
+					if (symbol == '"' && *read == '\\' && read + 1 != end)
+					{
+						++read;
+					}
+					*write++ = *read++;
+				}
+				if (read == end)
+				{
+					return false;
+				}
+				++read;
+				continue;
+			}
+			if (symbol == '\\' && read + 1 != end)
+			{
+				++read;
+			}
+			*write++ = *read++;
+		}
+
+		if (!on_token(std::string_view(token_begin, static_cast<size_t>(write - token_begin))))
+		{
+			return true;
+		}
+	}
+}
+
+// Replaces "@path" argv elements with tokens of the response file. Files can
+// include other files the same way, relative paths of included files are
+// resolved against the directory of the including file. Recursive includes
+// and includes deeper than max_nesting_depth are reported as errors.
+// Tokens refer to argv and to mapped files, which are kept until destruction.
+class ArgsResponseFiles
+{
+
+public:
+	// Files of argv have depth 1.
+	static constexpr size_t max_nesting_depth = 32;
+
+	explicit ArgsResponseFiles(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	// Error token refers to argv or to mapped files.
+	ArgsParseError Expand(size_t argc, const char* const* argv);
+
+	const std::pmr::vector<std::string_view>& GetTokens() const;
+
+	static bool IsResponseFile(std::string_view token);
+
+private:
+	ArgsParseError ExpandFile(std::string_view path, size_t argv_index);
+
+private:
+	std::pmr::vector<MappedFile> files_;
+	std::pmr::vector<std::string_view> tokens_;
+	// Canonical paths of files being expanded.
+	std::vector<std::string> include_stack_;
+};
+
+} // namespace SimpleArgsParser
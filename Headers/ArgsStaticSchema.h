@@ -0,0 +1,788 @@
+#pragma once
+
+#include "ArgsHelp.h"
+#include "ArgsListSplitter.h"
+#include "ArgsParseError.h"
+#include "ArgsParserException.h"
+#include "ArgsParserHelpStruct.h"
+#include "ArgsTokenParser.h"
+#include "ArgStringParsers.h"
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+namespace StaticSchemaDetails
+{
+
+template<typename MemberPointer>
+struct MemberTraits;
+
+template<typename Class, typename Type>
+struct MemberTraits<Type Class::*>
+{
+	using ClassType = Class;
+	using ValueType = Type;
+};
+
+template<typename Type>
+struct IsVector : std::false_type
+{};
+
+template<typename Type>
+struct IsVector<std::vector<Type>> : std::true_type
+{};
+
+// Default of types which can't be constructed at compile time, such options
+// take the default from the member initializer of the result struct.
+struct NoDefault
+{};
+
+template<typename Type>
+using DefaultType = std::conditional_t<
+	std::is_arithmetic_v<Type>,
+	Type,
+	std::conditional_t<std::is_same_v<Type, std::string>, std::string_view, NoDefault>>;
+
+// FNV-1a, full and short names with the same text get different hashes.
+constexpr uint64_t HashName(std::string_view name, bool is_short)
+{
+	uint64_t hash = is_short ? 14695981039346656037ull ^ 0x2d : 14695981039346656037ull;
+	for (const auto symbol : name)
+	{
+		hash ^= static_cast<unsigned char>(symbol);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+// Low bits of FNV-1a depend only on low bits of the input, so the hash is
+// mixed (murmur3 finalizer) before it's reduced to a bucket or slot.
+constexpr uint64_t Mix(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ull;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+constexpr size_t NextPowerOfTwo(size_t value)
+{
+	size_t result = 1;
+	while (result < value)
+	{
+		result *= 2;
+	}
+	return result;
+}
+
+// Converts a value of scalar option or an item of list option.
+template<typename Type>
+ConvertStatus ConvertValue(std::string_view value, Type& result, std::string& error)
+{
+	if constexpr (std::is_arithmetic_v<Type>)
+	{
+		return ConvertFromString(value, result);
+	}
+	else if constexpr (std::is_same_v<Type, std::string>)
+	{
+		result.assign(value.data(), value.size());
+		return ConvertStatus::Ok;
+	}
+	else
+	{
+		return CallUserConverter(
+			value,
+			[&]() { result = ParseFromString(value, ArgsParserHelpStruct<Type>()); },
+			error);
+	}
+}
+
+} // namespace StaticSchemaDetails
+
+// Option of a static schema bound to a member of the result struct. Option
+// name is "full" or "full,short" without '-', invalid names are compile errors
+// when the schema is constexpr.
+template<auto Member, bool IsFlag = false>
+class StaticArg
+{
+	using Traits = StaticSchemaDetails::MemberTraits<decltype(Member)>;
+
+public:
+	using ResultType = typename Traits::ClassType;
+	using ValueType = typename Traits::ValueType;
+	using DefaultType = StaticSchemaDetails::DefaultType<ValueType>;
+
+	static constexpr bool is_flag = IsFlag;
+	static constexpr bool is_list = StaticSchemaDetails::IsVector<ValueType>::value;
+
+	static_assert(!IsFlag || std::is_same_v<ValueType, bool>, "Flag must be bound to bool member.");
+
+	constexpr StaticArg(std::string_view option_name, std::string_view help)
+		: full_name_(SplitOptionName(option_name).full_name)
+		, short_name_(SplitOptionName(option_name).short_name)
+		, help_(help)
+	{}
+
+	constexpr StaticArg& SetRequired()
+	{
+		required_ = true;
+		return *this;
+	}
+
+	constexpr StaticArg& SetDefault(DefaultType value)
+	{
+		static_assert(!IsFlag && !std::is_same_v<DefaultType, StaticSchemaDetails::NoDefault>,
+			"Default of this option is taken from the result struct.");
+		default_value_ = value;
+		has_default_ = true;
+		return *this;
+	}
+
+	constexpr StaticArg& SetDelimiter(char delimiter)
+	{
+		static_assert(is_list, "Delimiter is set only for list options.");
+		delimiter_ = delimiter;
+		return *this;
+	}
+
+	constexpr std::string_view GetFullName() const
+	{
+		return full_name_;
+	}
+
+	constexpr std::string_view GetShortName() const
+	{
+		return short_name_;
+	}
+
+	constexpr std::string_view GetHelp() const
+	{
+		return help_;
+	}
+
+	constexpr bool IsRequired() const
+	{
+		return required_;
+	}
+
+	constexpr bool HasDefaultValue() const
+	{
+		return has_default_;
+	}
+
+	std::string GetStringDefaultValue() const
+	{
+		if constexpr (std::is_arithmetic_v<ValueType>)
+		{
+			return has_default_ ? ConvertToString(default_value_) : std::string();
+		}
+		else if constexpr (std::is_same_v<ValueType, std::string>)
+		{
+			return std::string(default_value_);
+		}
+		else
+		{
+			return std::string();
+		}
+	}
+
+	void ApplyDefault(ResultType& result) const
+	{
+		if constexpr (!std::is_same_v<DefaultType, StaticSchemaDetails::NoDefault>)
+		{
+			if (has_default_)
+			{
+				result.*Member = ValueType(default_value_);
+			}
+		}
+	}
+
+	// Value of flag is checked by the schema, the flag is only set here.
+	// The first occurrence of list option replaces the member default.
+	ConvertStatus Parse(std::string_view value, ResultType& result, std::string& error, bool first_occurrence) const
+	{
+		static_cast<void>(first_occurrence);
+		if constexpr (IsFlag)
+		{
+			result.*Member = true;
+			return ConvertStatus::Ok;
+		}
+		else if constexpr (is_list)
+		{
+			auto& values = result.*Member;
+			if (first_occurrence)
+			{
+				values.clear();
+			}
+			values.reserve(values.size() + CountListItems(value, delimiter_));
+			auto status = ConvertStatus::Ok;
+			SplitList(
+				value,
+				delimiter_,
+				[&values, &status, &error](std::string_view item)
+				{
+					typename ValueType::value_type converted{};
+					status = StaticSchemaDetails::ConvertValue(item, converted, error);
+					if (status != ConvertStatus::Ok)
+					{
+						if (error.empty())
+						{
+							error = GetConvertErrorMessage(item, status);
+						}
+						return false;
+					}
+					values.push_back(std::move(converted));
+					return true;
+				});
+			return status;
+		}
+		else
+		{
+			return StaticSchemaDetails::ConvertValue(value, result.*Member, error);
+		}
+	}
+
+private:
+	std::string_view full_name_;
+	std::string_view short_name_;
+	std::string_view help_;
+	DefaultType default_value_{};
+	bool has_default_ = false;
+	bool required_ = false;
+	char delimiter_ = ',';
+};
+
+template<auto Member>
+using StaticFlag = StaticArg<Member, true>;
+
+// Result of TryParseStaticArgs: either the filled struct or the parse error.
+template<typename Result>
+class StaticArgsParseResult
+{
+
+public:
+	StaticArgsParseResult(Result value, bool help_requested)
+		: value_(std::move(value))
+		, help_requested_(help_requested)
+	{}
+
+	StaticArgsParseResult(ArgsParseError error)
+		: error_(std::move(error))
+	{}
+
+	bool HasValue() const
+	{
+		return value_.has_value();
+	}
+
+	explicit operator bool() const
+	{
+		return HasValue();
+	}
+
+	const Result& GetValue() const&
+	{
+		if (!value_)
+		{
+			throw ArgsParserException(error_.GetMessage());
+		}
+		return *value_;
+	}
+
+	Result&& GetValue() &&
+	{
+		if (!value_)
+		{
+			throw ArgsParserException(error_.GetMessage());
+		}
+		return std::move(*value_);
+	}
+
+	const ArgsParseError& GetError() const
+	{
+		return error_;
+	}
+
+	// --help or -h was set, help is rendered by the schema.
+	bool IsHelpRequested() const
+	{
+		return help_requested_;
+	}
+
+private:
+	std::optional<Result> value_;
+	ArgsParseError error_;
+	bool help_requested_ = false;
+};
+
+// Option set known at compile time. A constexpr schema validates names and
+// builds a perfect hash of them (hash and displace) during compilation, so it
+// costs nothing at startup. Values are converted straight into the members of
+// the result struct through a table of per-option functions.
+// Abbreviations, response files, environment and config values are supported
+// only by ArgsInitializer.
+template<typename Result, typename... Args>
+class StaticSchema
+{
+	static_assert(sizeof...(Args) > 0, "Static schema must have options.");
+	static_assert(
+		(std::is_same_v<typename Args::ResultType, Result> && ...),
+		"Options must be bound to members of one struct.");
+
+public:
+	static constexpr size_t options_count = sizeof...(Args);
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	constexpr explicit StaticSchema(std::string_view description, Args... args)
+		: description_(description)
+		, args_(std::move(args)...)
+	{
+		InitOptions(std::index_sequence_for<Args...>());
+		BuildTable();
+		BuildHelpOrder();
+	}
+
+	// Index of the option named by the token ("--full" or "-short") or npos.
+	constexpr size_t Find(std::string_view token) const
+	{
+		bool is_short = false;
+		if (token.size() > 2 && token[0] == '-' && token[1] == '-')
+		{
+			token.remove_prefix(2);
+		}
+		else if (token.size() > 1 && token[0] == '-' && token[1] != '-')
+		{
+			token.remove_prefix(1);
+			is_short = true;
+		}
+		else
+		{
+			return npos;
+		}
+
+		const auto hash = StaticSchemaDetails::HashName(token, is_short);
+		const auto key = slots_[GetSlot(hash, seeds_[GetBucket(hash)])];
+		if (key == npos || (key % 2 == 1) != is_short || GetKeyName(key) != token)
+		{
+			return npos;
+		}
+		return key / 2;
+	}
+
+	constexpr std::string_view GetDescription() const
+	{
+		return description_;
+	}
+
+	StaticArgsParseResult<Result> TryParse(const int argc, const char* const* argv) const
+	{
+		if (argc <= 0)
+		{
+			return ArgsParseError(ArgsErrorCode::IncorrectArgc);
+		}
+		if (argv == nullptr)
+		{
+			return ArgsParseError(ArgsErrorCode::IncorrectArgv);
+		}
+
+		Result result{};
+		ApplyDefaults(result, std::index_sequence_for<Args...>());
+		std::bitset<options_count> filled_options;
+		bool help_requested = false;
+		SchemaOptions options(*this, result, filled_options, help_requested);
+		if (auto error = ParseOptionTokens(ArgvTokens(static_cast<size_t>(argc), argv), options);
+			error.GetCode() != ArgsErrorCode::None)
+		{
+			return error;
+		}
+
+		// All missing options are reported in the order of declaration, as ArgsInitializer does.
+		std::vector<size_t> missing_params;
+		for (size_t index = 0; index < options_count; ++index)
+		{
+			if (options_[index].required && !filled_options.test(index))
+			{
+				missing_params.push_back(index);
+			}
+		}
+		if (!missing_params.empty())
+		{
+			// Names of the schema are kept without "--".
+			ArgsParseError required_error(ArgsErrorCode::RequiredParamNotSet);
+			required_error.SetParams(std::move(missing_params), this, &GetOptionFullName, "--");
+			return required_error;
+		}
+		return StaticArgsParseResult<Result>(std::move(result), help_requested);
+	}
+
+	// Same layout as help of ArgsInitializer, options are sorted by full name.
+	std::string GetHelp(std::string_view program_name, size_t max_size_arg_help_desc = 40, size_t max_size_arg_help_info = 40) const
+	{
+		std::array<std::string, options_count> default_values;
+		GetDefaultValues(default_values, std::index_sequence_for<Args...>());
+
+		std::string result;
+		AppendHelpHeader(result, program_name, description_);
+		std::string full_name;
+		std::string short_name;
+		for (const auto index : help_order_)
+		{
+			const auto& option = options_[index];
+			full_name.assign("--").append(option.full_name);
+			short_name.clear();
+			if (!option.short_name.empty())
+			{
+				short_name.assign("-").append(option.short_name);
+			}
+
+			ArgHelpRow row;
+			row.full_name = full_name;
+			row.short_name = short_name;
+			row.help = option.help;
+			row.has_value = option.has_value;
+			row.has_default = option.has_default;
+			row.default_value = default_values[index];
+			AppendOptionHelp(result, row, max_size_arg_help_desc, max_size_arg_help_info);
+		}
+		return result;
+	}
+
+	void WriteHelp(std::ostream& stream, std::string_view program_name) const
+	{
+		const auto help = GetHelp(program_name);
+		stream.write(help.data(), static_cast<std::streamsize>(help.size()));
+	}
+
+private:
+	struct Option
+	{
+		std::string_view full_name;
+		std::string_view short_name;
+		std::string_view help;
+		bool has_value = false;
+		bool has_default = false;
+		bool is_list = false;
+		bool required = false;
+	};
+
+	using ParseFunction = ConvertStatus (*)(const StaticSchema&, std::string_view, Result&, std::string&, bool);
+
+	// Resolves param names of errors, the schema must outlive them.
+	static std::string_view GetOptionFullName(const void* schema, size_t index)
+	{
+		return static_cast<const StaticSchema*>(schema)->options_[index].full_name;
+	}
+
+	// Full name of option i has key 2 * i, short name has key 2 * i + 1.
+	static constexpr size_t keys_count = options_count * 2;
+	static constexpr size_t buckets_count = StaticSchemaDetails::NextPowerOfTwo(options_count);
+	// Load factor <= 0.5 keeps search of bucket seeds short.
+	static constexpr size_t slots_count = StaticSchemaDetails::NextPowerOfTwo(keys_count * 2);
+
+	template<size_t... Indexes>
+	constexpr void InitOptions(std::index_sequence<Indexes...>)
+	{
+		((options_[Indexes] = Option{
+			std::get<Indexes>(args_).GetFullName(),
+			std::get<Indexes>(args_).GetShortName(),
+			std::get<Indexes>(args_).GetHelp(),
+			!Args::is_flag,
+			std::get<Indexes>(args_).HasDefaultValue(),
+			Args::is_list,
+			std::get<Indexes>(args_).IsRequired() }), ...);
+	}
+
+	constexpr std::string_view GetKeyName(size_t key) const
+	{
+		return key % 2 == 0 ? options_[key / 2].full_name : options_[key / 2].short_name;
+	}
+
+	static constexpr size_t GetBucket(uint64_t hash)
+	{
+		return static_cast<size_t>(StaticSchemaDetails::Mix(hash)) & (buckets_count - 1);
+	}
+
+	static constexpr size_t GetSlot(uint64_t hash, uint64_t seed)
+	{
+		return static_cast<size_t>(StaticSchemaDetails::Mix(hash ^ (seed * 0x9e3779b97f4a7c15ull))) & (slots_count - 1);
+	}
+
+	// Keys are split into buckets, then for every bucket (largest first) a seed
+	// is searched which puts all its keys into free slots. Lookup hashes the
+	// name once and reads one seed and one slot.
+	constexpr void BuildTable()
+	{
+		std::array<uint64_t, keys_count> hashes{};
+		std::array<size_t, keys_count> key_buckets{};
+		std::array<size_t, buckets_count> bucket_sizes{};
+		for (size_t key = 0; key < keys_count; ++key)
+		{
+			const auto name = GetKeyName(key);
+			if (name.empty())
+			{
+				continue;
+			}
+			hashes[key] = StaticSchemaDetails::HashName(name, key % 2 == 1);
+			key_buckets[key] = GetBucket(hashes[key]);
+			++bucket_sizes[key_buckets[key]];
+			for (size_t other = key % 2; other < key; other += 2)
+			{
+				if (hashes[other] == hashes[key] && GetKeyName(other) == name)
+				{
+					throw ArgsParserException(
+						(key % 2 == 0 ? "Duplicate full option name --" : "Duplicate short option name -")
+						+ std::string(name) + ".");
+				}
+			}
+		}
+
+		std::array<size_t, buckets_count> order{};
+		for (size_t i = 0; i < buckets_count; ++i)
+		{
+			order[i] = i;
+			for (size_t j = i; j > 0 && bucket_sizes[order[j - 1]] < bucket_sizes[order[j]]; --j)
+			{
+				const auto bucket = order[j];
+				order[j] = order[j - 1];
+				order[j - 1] = bucket;
+			}
+		}
+
+		for (auto& slot : slots_)
+		{
+			slot = npos;
+		}
+		std::array<size_t, keys_count> bucket_keys{};
+		std::array<size_t, keys_count> positions{};
+		for (const auto bucket : order)
+		{
+			size_t bucket_keys_count = 0;
+			for (size_t key = 0; key < keys_count; ++key)
+			{
+				if (!GetKeyName(key).empty() && key_buckets[key] == bucket)
+				{
+					bucket_keys[bucket_keys_count++] = key;
+				}
+			}
+			if (bucket_keys_count == 0)
+			{
+				break;
+			}
+
+			for (uint64_t seed = 1;; ++seed)
+			{
+				bool placed = true;
+				for (size_t i = 0; i < bucket_keys_count && placed; ++i)
+				{
+					positions[i] = GetSlot(hashes[bucket_keys[i]], seed);
+					placed = slots_[positions[i]] == npos;
+					for (size_t j = 0; j < i && placed; ++j)
+					{
+						placed = positions[j] != positions[i];
+					}
+				}
+				if (placed)
+				{
+					for (size_t i = 0; i < bucket_keys_count; ++i)
+					{
+						slots_[positions[i]] = bucket_keys[i];
+					}
+					seeds_[bucket] = seed;
+					break;
+				}
+			}
+		}
+	}
+
+	constexpr void BuildHelpOrder()
+	{
+		for (size_t i = 0; i < options_count; ++i)
+		{
+			help_order_[i] = i;
+			for (size_t j = i; j > 0 && options_[help_order_[j]].full_name < options_[help_order_[j - 1]].full_name; --j)
+			{
+				const auto index = help_order_[j];
+				help_order_[j] = help_order_[j - 1];
+				help_order_[j - 1] = index;
+			}
+		}
+	}
+
+	template<size_t... Indexes>
+	void ApplyDefaults(Result& result, std::index_sequence<Indexes...>) const
+	{
+		(std::get<Indexes>(args_).ApplyDefault(result), ...);
+	}
+
+	template<size_t... Indexes>
+	void GetDefaultValues(std::array<std::string, options_count>& values, std::index_sequence<Indexes...>) const
+	{
+		((values[Indexes] = std::get<Indexes>(args_).GetStringDefaultValue()), ...);
+	}
+
+	template<size_t Index>
+	static ConvertStatus ParseOption(
+		const StaticSchema& schema,
+		std::string_view value,
+		Result& result,
+		std::string& error,
+		bool first_occurrence)
+	{
+		return std::get<Index>(schema.args_).Parse(value, result, error, first_occurrence);
+	}
+
+	template<size_t... Indexes>
+	static constexpr std::array<ParseFunction, options_count> MakeParsers(std::index_sequence<Indexes...>)
+	{
+		return { { &ParseOption<Indexes>... } };
+	}
+
+	static ParseFunction GetParser(size_t index)
+	{
+		static constexpr auto parsers = MakeParsers(std::index_sequence_for<Args...>());
+		return parsers[index];
+	}
+
+	// Options of the schema for ParseOptionTokens, values are converted into the result.
+	class SchemaOptions
+	{
+
+	public:
+		SchemaOptions(
+			const StaticSchema& schema,
+			Result& result,
+			std::bitset<options_count>& filled_options,
+			bool& help_requested)
+			: schema_(schema)
+			, result_(result)
+			, filled_options_(filled_options)
+			, help_requested_(help_requested)
+		{}
+
+		size_t Find(std::string_view name, ArgsErrorCode& code) const
+		{
+			const auto index = schema_.Find(name);
+			code = index == npos ? ArgsErrorCode::UnknownParam : ArgsErrorCode::None;
+			return index == npos ? unknown_option : index;
+		}
+
+		size_t FindShort(std::string_view name) const
+		{
+			const auto index = schema_.Find(name);
+			return index == npos ? unknown_option : index;
+		}
+
+		bool HasValue(size_t index) const
+		{
+			return schema_.options_[index].has_value;
+		}
+
+		bool IsMultiValued(size_t index) const
+		{
+			return schema_.options_[index].is_list;
+		}
+
+		bool IsSet(size_t index) const
+		{
+			return filled_options_.test(index);
+		}
+
+		void SetFlag(size_t index)
+		{
+			GetParser(index)(schema_, {}, result_, error_, true);
+			filled_options_.set(index);
+		}
+
+		ArgsParseError Store(size_t index, std::string_view value, size_t argv_index)
+		{
+			const auto status = GetParser(index)(schema_, value, result_, error_, !filled_options_.test(index));
+			if (status != ConvertStatus::Ok)
+			{
+				return ArgsParseError(
+					status == ConvertStatus::OutOfRange ? ArgsErrorCode::ValueOutOfRange : ArgsErrorCode::IncorrectValue,
+					argv_index,
+					value,
+					std::move(error_));
+			}
+			filled_options_.set(index);
+			return ArgsParseError();
+		}
+
+		ArgsParseError MakeOptionError(ArgsErrorCode code, size_t argv_index, std::string_view token) const
+		{
+			return ArgsParseError(code, argv_index, token);
+		}
+
+		void OnHelp()
+		{
+			help_requested_ = true;
+		}
+
+	private:
+		const StaticSchema& schema_;
+		Result& result_;
+		std::bitset<options_count>& filled_options_;
+		bool& help_requested_;
+		// Error message of user value converter.
+		std::string error_;
+	};
+
+private:
+	std::string_view description_;
+	std::tuple<Args...> args_;
+	std::array<Option, options_count> options_{};
+	std::array<uint64_t, buckets_count> seeds_{};
+	std::array<size_t, slots_count> slots_{};
+	// Option indexes sorted by full name.
+	std::array<size_t, options_count> help_order_{};
+};
+
+// Result type is the struct the options are bound to:
+//   constexpr auto schema = MakeStaticSchema(
+//       "Description.",
+//       StaticArg<&Options::port>("port,p", "Port.").SetDefault(80),
+//       StaticFlag<&Options::verbose>("verbose,v", "Verbose output."));
+template<typename... Args>
+constexpr auto MakeStaticSchema(std::string_view description, Args... args)
+{
+	using Result = typename std::tuple_element_t<0, std::tuple<Args...>>::ResultType;
+	return StaticSchema<Result, Args...>(description, std::move(args)...);
+}
+
+// Doesn't throw on incorrect input, errors are returned in the result.
+template<typename Result, typename... Args>
+StaticArgsParseResult<Result> TryParseStaticArgs(
+	const int argc,
+	const char* const* argv,
+	const StaticSchema<Result, Args...>& schema)
+{
+	return schema.TryParse(argc, argv);
+}
+
+// Throws ArgsParserException with the message of TryParseStaticArgs error.
+template<typename Result, typename... Args>
+Result ParseStaticArgs(
+	const int argc,
+	const char* const* argv,
+	const StaticSchema<Result, Args...>& schema)
+{
+	return TryParseStaticArgs(argc, argv, schema).GetValue();
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ArgsParser.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace SimpleArgsParser
+{
+
+// Registers options of a subcommand in its initializer.
+using SubcommandFactory = std::function<void(ArgsInitializer&)>;
+
+// Result of ArgsSubcommands::TryParse. Containers refer to the initializers
+// of ArgsSubcommands, so the result must not outlive it.
+class SubcommandParseResult
+{
+
+public:
+	SubcommandParseResult(
+		ArgsContainer global_args,
+		std::string_view subcommand = {},
+		std::optional<ArgsContainer> subcommand_args = std::nullopt);
+	SubcommandParseResult(ArgsParseError error);
+
+	bool HasValue() const;
+	explicit operator bool() const;
+
+	const ArgsContainer& GetGlobalArgs() const;
+
+	// Subcommand can be omitted, e.g. for "program --help".
+	bool HasSubcommand() const;
+	// Refers to argv.
+	std::string_view GetSubcommand() const;
+	const ArgsContainer& GetSubcommandArgs() const;
+
+	// Argv index of subcommand option error is counted from the subcommand name.
+	const ArgsParseError& GetError() const;
+
+private:
+	std::optional<ArgsContainer> global_args_;
+	std::string_view subcommand_;
+	std::optional<ArgsContainer> subcommand_args_;
+	ArgsParseError error_;
+};
+
+// Command line "program [global options] subcommand [subcommand options]".
+// Initializer of a subcommand is built by its factory and frozen when the
+// subcommand is used for the first time, so startup cost depends only on
+// the invoked subcommand. Built initializers are kept, building is thread-safe.
+class ArgsSubcommands
+{
+
+public:
+	// Global initializer must outlive the object.
+	explicit ArgsSubcommands(const ArgsInitializer& global_initializer);
+
+	ArgsSubcommands& Add(std::string name, std::string help, SubcommandFactory factory);
+
+	bool HasSubcommand(std::string_view name) const;
+
+	// Throws ArgsParserException if the subcommand is unknown.
+	const ArgsInitializer& GetInitializer(std::string_view name) const;
+	bool IsInitializerBuilt(std::string_view name) const;
+
+	// Global options are parsed up to the first positional argument, which
+	// is the subcommand name, the rest of argv is parsed by the subcommand.
+	SubcommandParseResult TryParse(
+		const int argc,
+		const char* const* argv,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+	// Throws ArgsParserException with the message of TryParse error.
+	SubcommandParseResult Parse(
+		const int argc,
+		const char* const* argv,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+	// Global options and the list of subcommands, subcommands aren't built.
+	std::string GetHelp(std::string_view program_name) const;
+	// Options of the subcommand, usage is shown as "program subcommand".
+	std::string GetSubcommandHelp(std::string_view program_name, std::string_view name) const;
+
+private:
+	struct Subcommand
+	{
+		std::string help;
+		SubcommandFactory factory;
+		std::once_flag build_flag;
+		std::unique_ptr<ArgsInitializer> initializer;
+		std::atomic<bool> built = false;
+	};
+
+	const ArgsInitializer& Build(Subcommand& subcommand) const;
+
+private:
+	const ArgsInitializer& global_initializer_;
+	// Subcommands are only built lazily after registration, the map itself isn't changed.
+	std::map<std::string, std::unique_ptr<Subcommand>, std::less<>> subcommands_;
+};
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "ArgsParseError.h"
+#include "ArgsParserException.h"
+#include "ArgStringParsers.h"
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace SimpleArgsParser
+{
+
+// Parts of option name "full" or "full, short", given without '-'.
+struct OptionNameParts
+{
+	std::string_view full_name;
+	std::string_view short_name;
+};
+
+constexpr std::string_view TrimOptionName(std::string_view value)
+{
+	while (!value.empty() && value.front() == ' ')
+	{
+		value.remove_prefix(1);
+	}
+	while (!value.empty() && value.back() == ' ')
+	{
+		value.remove_suffix(1);
+	}
+	return value;
+}
+
+// Spaces around the names are skipped, spaces inside them are errors. Shared by
+// ArgsInitializer and StaticArg, which checks names at compile time.
+constexpr OptionNameParts SplitOptionName(std::string_view option_name)
+{
+	const auto pos = option_name.find(',');
+	OptionNameParts parts{ TrimOptionName(option_name.substr(0, pos)), {} };
+	if (parts.full_name.empty())
+	{
+		throw ArgsParserException(pos == std::string_view::npos ? "Empty option name." : "Empty full option name.");
+	}
+	if (parts.full_name.front() == '-')
+	{
+		throw ArgsParserException(
+			"Incorrect full option name (please remove '-') " + std::string(TrimOptionName(option_name)) + ".");
+	}
+	if (pos != std::string_view::npos)
+	{
+		parts.short_name = TrimOptionName(option_name.substr(pos + 1));
+		if (parts.short_name.empty())
+		{
+			throw ArgsParserException("Empty short option name.");
+		}
+		if (parts.short_name.front() == '-')
+		{
+			throw ArgsParserException(
+				"Incorrect short option name (please remove '-') " + std::string(parts.short_name) + ".");
+		}
+	}
+	if (parts.full_name.find(' ') != std::string_view::npos || parts.short_name.find(' ') != std::string_view::npos)
+	{
+		throw ArgsParserException(
+			"Incorrect option name (please remove spaces) " + std::string(TrimOptionName(option_name)) + ".");
+	}
+	if (parts.full_name == "help" || parts.short_name == "h")
+	{
+		throw ArgsParserException("--help, -h reserved args.");
+	}
+	return parts;
+}
+
+// Argv elements are read as is, null element is reported as error.
+class ArgvTokens
+{
+
+public:
+	// Argv outlives the parse, so lazy values can refer to it.
+	static constexpr bool outlive_parse = true;
+
+	constexpr ArgvTokens(size_t size, const char* const* argv)
+		: size_(size)
+		, argv_(argv)
+	{}
+
+	size_t Size() const
+	{
+		return size_;
+	}
+
+	bool Get(size_t index, std::string_view& token) const
+	{
+		if (argv_[index] == nullptr)
+		{
+			return false;
+		}
+		token = argv_[index];
+		return true;
+	}
+
+private:
+	size_t size_;
+	const char* const* argv_;
+};
+
+// Index of option which isn't found.
+inline constexpr size_t unknown_option = std::numeric_limits<size_t>::max();
+
+// "-abc" is a bundle of one-symbol short options, the first option which has
+// a value takes the rest of the token ("-j8") or the next token as the value.
+constexpr bool IsShortOptionsBundle(std::string_view param)
+{
+	return param.size() > 2 && param[0] == '-' && param[1] != '-';
+}
+
+// Options are the option set of ArgsInitializer or StaticSchema addressed by
+// option index, they resolve names and store values:
+//   size_t Find(std::string_view name, ArgsErrorCode& code) const;
+//       index or unknown_option with UnknownParam or AmbiguousParam code;
+//   size_t FindShort(std::string_view name) const;
+//       exact match of "-x" or unknown_option;
+//   bool HasValue(size_t index) const; (false for flags)
+//   bool IsMultiValued(size_t index) const;
+//   bool IsSet(size_t index) const;
+//   void SetFlag(size_t index);
+//   ArgsParseError Store(size_t index, std::string_view value, size_t argv_index);
+//   ArgsParseError MakeOptionError(ArgsErrorCode code, size_t argv_index, std::string_view token) const;
+//   void OnHelp();
+
+// The first occurrence of scalar option wins, list options collect all of them.
+// Flags accept boolean values, false value leaves the flag unset.
+template<typename Options>
+ArgsParseError StoreOptionValue(Options& options, size_t index, std::string_view value, size_t argv_index)
+{
+	if (!options.HasValue(index))
+	{
+		bool flag = false;
+		if (ConvertFromString(value, flag) != ConvertStatus::Ok)
+		{
+			return ArgsParseError(ArgsErrorCode::IncorrectValue, argv_index, value);
+		}
+		if (flag)
+		{
+			options.SetFlag(index);
+		}
+		return ArgsParseError();
+	}
+	if (options.IsSet(index) && !options.IsMultiValued(index))
+	{
+		return ArgsParseError();
+	}
+	return options.Store(index, value, argv_index);
+}
+
+// Tokens from index 1 are options ("--full", "-short", "--full=value" and
+// bundles of short options) and their values.
+// If positional_index is set, parse stops at the first token which is neither
+// an option nor its value, index of the token (or size of tokens) is stored there.
+template<typename Tokens, typename Options>
+ArgsParseError ParseOptionTokens(const Tokens& tokens, Options& options, size_t* positional_index = nullptr)
+{
+	const auto size = tokens.Size();
+	if (positional_index != nullptr)
+	{
+		*positional_index = size;
+	}
+	for (size_t i = 1; i < size; ++i)
+	{
+		std::string_view param;
+		if (!tokens.Get(i, param))
+		{
+			return ArgsParseError(ArgsErrorCode::IncorrectArgv, i);
+		}
+
+		if (positional_index != nullptr && (param.empty() || param.front() != '-'))
+		{
+			*positional_index = i;
+			break;
+		}
+
+		if (param == "--help" || param == "-h")
+		{
+			options.OnHelp();
+			continue;
+		}
+
+		// Names are matched exactly first, so options with '=' in the name and
+		// multi-symbol short names take precedence over splitting of the token.
+		auto code = ArgsErrorCode::None;
+		auto index = options.Find(param, code);
+		if (index == unknown_option && code == ArgsErrorCode::UnknownParam)
+		{
+			if (const auto separator = param.find('='); param.substr(0, 2) == "--" && separator != std::string_view::npos)
+			{
+				const auto name = param.substr(0, separator);
+				index = options.Find(name, code);
+				if (index == unknown_option)
+				{
+					return options.MakeOptionError(code, i, name);
+				}
+				if (auto value_error = StoreOptionValue(options, index, param.substr(separator + 1), i);
+					value_error.GetCode() != ArgsErrorCode::None)
+				{
+					return value_error;
+				}
+				continue;
+			}
+
+			if (IsShortOptionsBundle(param))
+			{
+				for (size_t pos = 1; pos < param.size(); ++pos)
+				{
+					const char short_name[] = { '-', param[pos] };
+					const auto short_index = options.FindShort(std::string_view(short_name, 2));
+					if (short_index == unknown_option)
+					{
+						return options.MakeOptionError(ArgsErrorCode::UnknownParam, i, param);
+					}
+					if (!options.HasValue(short_index))
+					{
+						options.SetFlag(short_index);
+						continue;
+					}
+
+					auto value = param.substr(pos + 1);
+					const auto param_index = i;
+					if (value.empty())
+					{
+						if (i + 1 == size || !tokens.Get(i + 1, value))
+						{
+							return ArgsParseError(ArgsErrorCode::MissingParamValue, param_index, param);
+						}
+						++i;
+					}
+					if (auto value_error = StoreOptionValue(options, short_index, value, i);
+						value_error.GetCode() != ArgsErrorCode::None)
+					{
+						return value_error;
+					}
+					break;
+				}
+				continue;
+			}
+		}
+		if (index == unknown_option)
+		{
+			return options.MakeOptionError(code, i, param);
+		}
+
+		if (!options.HasValue(index))
+		{
+			options.SetFlag(index);
+			continue;
+		}
+
+		std::string_view value;
+		if (i + 1 == size || !tokens.Get(i + 1, value))
+		{
+			return ArgsParseError(ArgsErrorCode::MissingParamValue, i, param);
+		}
+		++i;
+
+		if (auto value_error = StoreOptionValue(options, index, value, i);
+			value_error.GetCode() != ArgsErrorCode::None)
+		{
+			return value_error;
+		}
+	}
+	return ArgsParseError();
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "ArgsBitset.h"
+#include "ArgsParserException.h"
+
+#include <any>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+// Value of lazy conversion, it's converted on the first read.
+struct ArgRawValue
+{
+	static constexpr size_t no_copy = static_cast<size_t>(-1);
+
+	std::string_view value;
+	// Index of the copy owned by the store if the value doesn't outlive it.
+	size_t copy = no_copy;
+};
+
+// Built-in value types are stored inline, any other type goes to std::any.
+using ArgSlot = std::variant<
+	std::monostate,
+	bool,
+	char,
+	signed char,
+	unsigned char,
+	wchar_t,
+	char16_t,
+	char32_t,
+	short,
+	unsigned short,
+	int,
+	unsigned int,
+	long,
+	unsigned long,
+	long long,
+	unsigned long long,
+	float,
+	double,
+	long double,
+	std::string,
+	ArgRawValue,
+	std::any>;
+
+template<typename Type, typename Variant>
+struct IsVariantAlternative;
+
+template<typename Type, typename... Types>
+struct IsVariantAlternative<Type, std::variant<Types...>>
+	: std::disjunction<std::is_same<Type, Types>...>
+{};
+
+template<typename Type>
+constexpr bool is_inline_slot_type_v =
+	IsVariantAlternative<Type, ArgSlot>::value
+	&& !std::is_same_v<Type, std::monostate>
+	&& !std::is_same_v<Type, ArgRawValue>
+	&& !std::is_same_v<Type, std::any>;
+
+template<typename Type, typename = void>
+struct HasClear : std::false_type
+{};
+
+template<typename Type>
+struct HasClear<Type, std::void_t<decltype(std::declval<Type&>().clear())>> : std::true_type
+{};
+
+// Contiguous storage of option values addressed by option index.
+// Slots are allocated from the memory resource on the first write, so a store
+// of bound options only doesn't allocate them. String values longer than
+// the small string buffer and user types still use the default heap.
+// Values stay in their slots after Reset, so a store which is refilled
+// reuses the capacity of strings and lists.
+class ArgsValueStore
+{
+
+public:
+	explicit ArgsValueStore(
+		size_t size = 0,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+	// Copies are allocated from the resource of the source.
+	ArgsValueStore(const ArgsValueStore& other);
+	ArgsValueStore(ArgsValueStore&& other) noexcept = default;
+	ArgsValueStore& operator=(const ArgsValueStore& other) = default;
+	ArgsValueStore& operator=(ArgsValueStore&& other) = default;
+
+	template<typename Type>
+	void Set(size_t index, Type value)
+	{
+		auto& slot = GetSlot(index);
+		if constexpr (is_inline_slot_type_v<Type>)
+		{
+			slot.template emplace<Type>(std::move(value));
+		}
+		else
+		{
+			slot.template emplace<std::any>(std::move(value));
+		}
+		MarkFilled(index);
+	}
+
+	// Sets an empty value and returns it to be filled in place. The value left
+	// in the slot by the previous fill is cleared, so its capacity is kept.
+	template<typename Type>
+	Type& Emplace(size_t index)
+	{
+		auto& slot = GetSlot(index);
+		MarkFilled(index);
+		Type* value = nullptr;
+		if constexpr (is_inline_slot_type_v<Type>)
+		{
+			value = std::get_if<Type>(&slot);
+			if (value == nullptr)
+			{
+				return slot.template emplace<Type>();
+			}
+		}
+		else
+		{
+			auto* any = std::get_if<std::any>(&slot);
+			value = any == nullptr ? nullptr : std::any_cast<Type>(any);
+			if (value == nullptr)
+			{
+				return std::any_cast<Type&>(slot.template emplace<std::any>(Type()));
+			}
+		}
+
+		if constexpr (HasClear<Type>::value)
+		{
+			value->clear();
+		}
+		else
+		{
+			*value = Type();
+		}
+		return *value;
+	}
+
+	// Returns nullptr if value isn't set or has another type.
+	template<typename Type>
+	const Type* Get(size_t index) const
+	{
+		const auto& slot = GetSlot(index);
+		if (!filled_.Test(index))
+		{
+			return nullptr;
+		}
+		if constexpr (is_inline_slot_type_v<Type>)
+		{
+			return std::get_if<Type>(&slot);
+		}
+		else
+		{
+			const auto* value = std::get_if<std::any>(&slot);
+			return value == nullptr ? nullptr : std::any_cast<Type>(value);
+		}
+	}
+
+	// Same as Get, but the value can be modified in place.
+	template<typename Type>
+	Type* GetMutable(size_t index)
+	{
+		return const_cast<Type*>(static_cast<const ArgsValueStore*>(this)->Get<Type>(index));
+	}
+
+	// Keeps the raw value, which must outlive the store, to be converted on the first read.
+	void SetRaw(size_t index, std::string_view value);
+	// Same as SetRaw, but the value is copied into the store.
+	void SetRawCopy(size_t index, std::string_view value);
+	// Returns false if the value isn't raw.
+	bool GetRaw(size_t index, std::string_view& value) const;
+
+	bool Has(size_t index) const;
+
+	// Marks the value of a bound option set, the value itself is written to
+	// the bound variable and isn't stored.
+	void SetBound(size_t index);
+	// Values of bound options are written to their variables and to the
+	// members of the object (if it isn't null) instead of the store.
+	// Disabled by default, so containers never write to bound variables.
+	void EnableBinding(void* object);
+	bool IsBindingEnabled() const;
+	void* GetBindObject() const;
+
+	size_t Size() const;
+	// New slots are unset.
+	void Resize(size_t size);
+
+	// Number of set values.
+	size_t Count() const;
+	const ArgsBitset& GetFilled() const;
+
+	// Marks all values unset without destroying them, raw copies are dropped.
+	void Reset();
+
+private:
+	// The bit is written only if it isn't set, so converting a raw value in
+	// place doesn't write the word read by other threads.
+	void MarkFilled(size_t index);
+
+	ArgSlot& GetSlot(size_t index);
+	const ArgSlot& GetSlot(size_t index) const;
+
+private:
+	std::pmr::vector<ArgSlot> slots_;
+	ArgsBitset filled_;
+	std::pmr::vector<std::pmr::string> raw_copies_;
+	bool binding_enabled_ = false;
+	void* bind_object_ = nullptr;
+};
+
+} // namespace SimpleArgsParser
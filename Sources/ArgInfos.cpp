@@ -6,16 +6,19 @@ namespace SimpleArgsParser
 {
 
 ArgInfos::ArgInfos(
-	std::string full_name,
-	std::string help,
-	std::unique_ptr<IArgValue> arg_value,
-	ArgOptions arg_options,
-	std::string short_name)
-	: full_name_(std::move(full_name))
-	, help_(std::move(help))
+	std::string_view full_name,
+	std::string_view help,
+	ArgValuePtr arg_value,
+	const ArgOptions& arg_options,
+	std::string_view short_name,
+	size_t index,
+	std::pmr::memory_resource* resource)
+	: full_name_(full_name, resource)
+	, help_(help, resource)
 	, arg_value_(std::move(arg_value))
-	, arg_options_(std::move(arg_options))
-	, short_name_(std::move(short_name))
+	, arg_options_(arg_options, resource)
+	, short_name_(short_name, resource)
+	, index_(index)
 {}
 
 const IArgValue& ArgInfos::GetValue() const
@@ -32,21 +35,26 @@ const ArgOptions& ArgInfos::GetOptions() const
 	return arg_options_;
 }
 
-const std::string& ArgInfos::GetHelp() const
+std::string_view ArgInfos::GetHelp() const
 {
 	return help_;
 }
 
-const std::string& ArgInfos::GetShortName() const
+std::string_view ArgInfos::GetShortName() const
 {
 	return short_name_;
 }
 
-const std::string& ArgInfos::GetFullName() const
+std::string_view ArgInfos::GetFullName() const
 {
 	return full_name_;
 }
 
+size_t ArgInfos::GetIndex() const
+{
+	return index_;
+}
+
 bool ArgInfos::HasValue() const
 {
 	return static_cast<bool>(arg_value_);
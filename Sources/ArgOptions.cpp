@@ -3,10 +3,28 @@
 namespace SimpleArgsParser
 {
 
+ArgOptions::ArgOptions(const ArgOptions& other, std::pmr::memory_resource* resource)
+	: required(other.required)
+	, env_name(other.env_name, resource)
+	, config_key(other.config_key, resource)
+{}
+
 ArgOptions& ArgOptions::SetRequired()
 {
 	required = true;
 	return *this;
 }
 
-} // namespace SimpleArgsParser
\ No newline at end of file
+ArgOptions& ArgOptions::SetEnv(std::string name)
+{
+	env_name.assign(name);
+	return *this;
+}
+
+ArgOptions& ArgOptions::SetConfigKey(std::string key)
+{
+	config_key.assign(key);
+	return *this;
+}
+
+} // namespace SimpleArgsParser
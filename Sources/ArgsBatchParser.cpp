@@ -0,0 +1,130 @@
+#include "../Headers/ArgsBatchParser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+constexpr size_t batch_chunk_size = 16;
+
+void ParseCommandLine(
+	const std::vector<const char*>& command_line,
+	const ArgsInitializer& argument_initializer,
+	BatchParseResult& result)
+{
+	try
+	{
+		auto parse_result = TryParseArgs(
+			static_cast<int>(command_line.size()),
+			command_line.data(),
+			argument_initializer);
+		if (parse_result)
+		{
+			result.args.emplace(std::move(parse_result).GetValue());
+		}
+		else
+		{
+			result.error = parse_result.GetError();
+		}
+	}
+	// Parse errors are returned by TryParseArgs, only failures like bad_alloc get here.
+	catch (const std::exception& exc)
+	{
+		result.error = ArgsParseError(ArgsErrorCode::InternalError, ArgsParseError::npos, {}, exc.what());
+	}
+	catch (...)
+	{
+		result.error = ArgsParseError(ArgsErrorCode::InternalError);
+	}
+}
+
+// Joins the started threads on any exit, so a failure on the calling
+// thread doesn't destroy joinable threads.
+class ThreadsJoiner
+{
+
+public:
+	explicit ThreadsJoiner(std::vector<std::thread>& threads)
+		: threads_(threads)
+	{}
+
+	~ThreadsJoiner()
+	{
+		for (auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+private:
+	std::vector<std::thread>& threads_;
+};
+
+} // namespace
+
+bool BatchParseResult::HasError() const
+{
+	return !args.has_value();
+}
+
+std::vector<BatchParseResult> ParseArgsBatch(
+	const std::vector<std::vector<const char*>>& command_lines,
+	const ArgsInitializer& argument_initializer,
+	size_t threads_count)
+{
+	std::vector<BatchParseResult> results(command_lines.size());
+	if (command_lines.empty())
+	{
+		return results;
+	}
+
+	if (threads_count == 0)
+	{
+		threads_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+	const auto chunks_count = (command_lines.size() + batch_chunk_size - 1) / batch_chunk_size;
+	threads_count = std::min(threads_count, chunks_count);
+
+	std::atomic<size_t> next_chunk{ 0 };
+	const auto worker = [&]()
+	{
+		for (auto chunk = next_chunk.fetch_add(1); chunk < chunks_count; chunk = next_chunk.fetch_add(1))
+		{
+			const auto begin = chunk * batch_chunk_size;
+			const auto end = std::min(begin + batch_chunk_size, command_lines.size());
+			for (auto i = begin; i < end; ++i)
+			{
+				ParseCommandLine(command_lines[i], argument_initializer, results[i]);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threads_count - 1);
+	{
+		ThreadsJoiner joiner(threads);
+		for (size_t i = 1; i < threads_count; ++i)
+		{
+			try
+			{
+				threads.emplace_back(worker);
+			}
+			// Chunks are taken from the shared counter, so the started threads
+			// and the calling one parse all command lines anyway.
+			catch (const std::system_error&)
+			{
+				break;
+			}
+		}
+		worker();
+	}
+	return results;
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,83 @@
+#include "../Headers/ArgsBitset.h"
+
+#include <algorithm>
+
+namespace SimpleArgsParser
+{
+
+ArgsBitset::ArgsBitset(size_t size, std::pmr::memory_resource* resource)
+	: words_((size + word_bits - 1) / word_bits, 0, resource)
+	, size_(size)
+{}
+
+ArgsBitset::ArgsBitset(const ArgsBitset& other)
+	: ArgsBitset(other, other.words_.get_allocator().resource())
+{}
+
+ArgsBitset::ArgsBitset(const ArgsBitset& other, std::pmr::memory_resource* resource)
+	: words_(other.words_, resource)
+	, size_(other.size_)
+{}
+
+size_t ArgsBitset::Size() const
+{
+	return size_;
+}
+
+void ArgsBitset::Resize(size_t size)
+{
+	words_.resize((size + word_bits - 1) / word_bits, 0);
+	size_ = size;
+	// Bits past the size are cleared, so growing again leaves them unset.
+	if (size % word_bits != 0)
+	{
+		words_.back() &= (uint64_t(1) << (size % word_bits)) - 1;
+	}
+}
+
+void ArgsBitset::Set(size_t index)
+{
+	words_[index / word_bits] |= uint64_t(1) << (index % word_bits);
+}
+
+bool ArgsBitset::Test(size_t index) const
+{
+	return (words_[index / word_bits] >> (index % word_bits)) & 1;
+}
+
+void ArgsBitset::Clear()
+{
+	std::fill(words_.begin(), words_.end(), 0);
+}
+
+size_t ArgsBitset::Count() const
+{
+	size_t count = 0;
+	for (const auto word : words_)
+	{
+		count += static_cast<size_t>(__builtin_popcountll(word));
+	}
+	return count;
+}
+
+size_t ArgsBitset::CountOr(const ArgsBitset& other) const
+{
+	size_t count = 0;
+	for (size_t i = 0; i < std::max(words_.size(), other.words_.size()); ++i)
+	{
+		count += static_cast<size_t>(__builtin_popcountll(GetWord(i) | other.GetWord(i)));
+	}
+	return count;
+}
+
+size_t ArgsBitset::GetWordsCount() const
+{
+	return words_.size();
+}
+
+uint64_t ArgsBitset::GetWord(size_t index) const
+{
+	return index < words_.size() ? words_[index] : 0;
+}
+
+} // namespace SimpleArgsParser
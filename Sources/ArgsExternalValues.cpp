@@ -0,0 +1,140 @@
+#include "../Headers/ArgsExternalValues.h"
+#include "../Headers/ArgsParser.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/stat.h>
+
+extern char** environ;
+
+namespace SimpleArgsParser
+{
+
+ArgsExternalValues::ArgsExternalValues(size_t options_count, std::pmr::memory_resource* resource)
+	: environment_values_(resource)
+	, values_(options_count, std::string_view(), resource)
+{}
+
+ArgsParseError ArgsExternalValues::Read(const ArgsInitializer& args_initializer)
+{
+	error_ = ArgsParseError();
+	if (args_initializer.HasConfigOptions() && !args_initializer.GetConfigFile().empty())
+	{
+		error_ = ReadConfigFile(args_initializer);
+		if (error_.GetCode() != ArgsErrorCode::None)
+		{
+			return error_;
+		}
+	}
+	if (args_initializer.HasEnvOptions())
+	{
+		ReadEnvironment(args_initializer);
+	}
+	return error_;
+}
+
+const ArgsParseError& ArgsExternalValues::GetError() const
+{
+	return error_;
+}
+
+bool ArgsExternalValues::Has(size_t index) const
+{
+	return values_[index].data() != nullptr;
+}
+
+std::string_view ArgsExternalValues::Get(size_t index) const
+{
+	return values_[index];
+}
+
+ArgsParseError ArgsExternalValues::ReadConfigFile(const ArgsInitializer& args_initializer)
+{
+	const auto path = args_initializer.GetConfigFile();
+	const std::string path_string(path);
+	if (!config_file_.Open(path_string.c_str()))
+	{
+		struct stat file_stat {};
+		if (::stat(path_string.c_str(), &file_stat) != 0 && errno == ENOENT)
+		{
+			return ArgsParseError();
+		}
+		return ArgsParseError(ArgsErrorCode::ConfigFileNotRead, ArgsParseError::npos, path);
+	}
+
+	// Key with section is built in one reused buffer.
+	std::string section_key;
+	const auto incorrect_line = ParseConfigFile(
+		std::string_view(config_file_.GetData(), config_file_.GetSize()),
+		[this, &args_initializer, &section_key](std::string_view section, std::string_view key, std::string_view value)
+		{
+			auto full_key = key;
+			if (!section.empty())
+			{
+				section_key.assign(section.data(), section.size());
+				section_key += '.';
+				section_key.append(key.data(), key.size());
+				full_key = section_key;
+			}
+			// Unknown keys are skipped, the file can be shared by several programs.
+			const auto index = args_initializer.FindConfigOption(full_key);
+			if (index != ArgsLookupTable::npos)
+			{
+				values_[index] = value;
+			}
+		});
+	if (incorrect_line != 0)
+	{
+		return ArgsParseError(
+			ArgsErrorCode::IncorrectConfigFile,
+			ArgsParseError::npos,
+			path,
+			"Incorrect line " + std::to_string(incorrect_line) + " of config file: " + path_string + ".");
+	}
+	return ArgsParseError();
+}
+
+void ArgsExternalValues::ReadEnvironment(const ArgsInitializer& args_initializer)
+{
+	if (environ == nullptr)
+	{
+		return;
+	}
+	const auto for_each_value = [&args_initializer](auto&& on_value)
+	{
+		for (char** variable = environ; *variable != nullptr; ++variable)
+		{
+			const char* const separator = std::strchr(*variable, '=');
+			if (separator == nullptr)
+			{
+				continue;
+			}
+			const std::string_view name(*variable, static_cast<size_t>(separator - *variable));
+			const auto index = args_initializer.FindEnvOption(name);
+			if (index != ArgsLookupTable::npos)
+			{
+				on_value(index, std::string_view(separator + 1));
+			}
+		}
+	};
+
+	// Values are copied into one buffer, reserved first so views into it stay valid.
+	size_t size = 0;
+	for_each_value([&size](size_t, std::string_view value) { size += value.size(); });
+	environment_values_.clear();
+	environment_values_.reserve(size);
+	for_each_value(
+		[this](size_t index, std::string_view value)
+		{
+			if (environment_values_.size() + value.size() > environment_values_.capacity())
+			{
+				return;
+			}
+			const auto offset = environment_values_.size();
+			environment_values_.append(value);
+			values_[index] = std::string_view(environment_values_.data() + offset, value.size());
+		});
+}
+
+} // namespace SimpleArgsParser
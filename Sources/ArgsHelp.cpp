@@ -0,0 +1,342 @@
+#include "../Headers/ArgsHelp.h"
+#include "../Headers/ArgsParser.h"
+
+#include <algorithm>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+class StreamOutput
+{
+
+public:
+	explicit StreamOutput(std::ostream& stream)
+		: stream_(stream)
+	{}
+
+	void Reserve(size_t)
+	{}
+
+	void Write(std::string_view value)
+	{
+		stream_.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	void WriteSpaces(size_t count)
+	{
+		static constexpr std::string_view spaces = "                                                                ";
+		while (count > 0)
+		{
+			const auto size = std::min(count, spaces.size());
+			Write(spaces.substr(0, size));
+			count -= size;
+		}
+	}
+
+private:
+	std::ostream& stream_;
+};
+
+template<typename String>
+class StringOutput
+{
+
+public:
+	explicit StringOutput(String& buffer)
+		: buffer_(buffer)
+	{}
+
+	void Reserve(size_t size)
+	{
+		buffer_.reserve(buffer_.size() + size);
+	}
+
+	void Write(std::string_view value)
+	{
+		buffer_.append(value.data(), value.size());
+	}
+
+	void WriteSpaces(size_t count)
+	{
+		buffer_.append(count, ' ');
+	}
+
+private:
+	String& buffer_;
+};
+
+template<typename Output>
+void WriteOptionHelp(
+	Output& output,
+	const ArgHelpRow& row,
+	const size_t max_size_arg_help_desc,
+	const size_t max_size_arg_help_info)
+{
+	// "  --full,-short arg(=default)"
+	size_t arg_string_size = 2 + row.full_name.size();
+	output.Write("  ");
+	output.Write(row.full_name);
+	if (!row.short_name.empty())
+	{
+		arg_string_size += 1 + row.short_name.size();
+		output.Write(",");
+		output.Write(row.short_name);
+	}
+	if (row.has_value)
+	{
+		arg_string_size += 4;
+		output.Write(" arg");
+		if (row.has_default)
+		{
+			arg_string_size += 3 + row.default_value.size();
+			output.Write("(=");
+			output.Write(row.default_value);
+			output.Write(")");
+		}
+	}
+
+	if (arg_string_size + 1 > max_size_arg_help_desc)
+	{
+		output.Write("\n");
+		output.WriteSpaces(max_size_arg_help_desc);
+	}
+	else
+	{
+		output.WriteSpaces(max_size_arg_help_desc - arg_string_size);
+	}
+
+	// A line is broken on the last space which fits into the info column,
+	// a word longer than the column takes the whole line.
+	const auto help = row.help;
+	size_t prev_local_pos = 0;
+	size_t start_line_pos = 0;
+
+	auto pos = help.find(' ', start_line_pos + 1);
+	while (pos != std::string_view::npos)
+	{
+		if (pos > start_line_pos + max_size_arg_help_info)
+		{
+			if (start_line_pos != 0)
+			{
+				output.WriteSpaces(max_size_arg_help_desc);
+			}
+			if (prev_local_pos == 0)
+			{
+				output.Write(help.substr(start_line_pos, pos - start_line_pos));
+				output.Write("\n");
+				start_line_pos = pos + 1;
+				pos = help.find(' ', start_line_pos);
+			}
+			else
+			{
+				output.Write(help.substr(start_line_pos, prev_local_pos));
+				output.Write("\n");
+				start_line_pos += prev_local_pos + 1;
+				prev_local_pos = 0;
+			}
+		}
+		else
+		{
+			prev_local_pos = pos - start_line_pos;
+			pos = help.find(' ', pos + 1);
+		}
+	}
+
+	if (help.size() > start_line_pos)
+	{
+		if (start_line_pos != 0)
+		{
+			output.WriteSpaces(max_size_arg_help_desc);
+		}
+		if (help.size() > max_size_arg_help_info + start_line_pos && prev_local_pos != 0)
+		{
+			output.Write(help.substr(start_line_pos, prev_local_pos));
+			output.Write("\n");
+			start_line_pos += prev_local_pos + 1;
+			if (help.size() > start_line_pos)
+			{
+				output.WriteSpaces(max_size_arg_help_desc);
+				output.Write(help.substr(start_line_pos));
+				output.Write("\n");
+			}
+		}
+		else
+		{
+			output.Write(help.substr(start_line_pos));
+			output.Write("\n");
+		}
+	}
+}
+
+template<typename Output>
+void WriteOptionsHelp(
+	Output& output,
+	const ArgsInfosMap& infos,
+	const size_t max_size_arg_help_desc,
+	const size_t max_size_arg_help_info)
+{
+	std::string default_value;
+	for (const auto& info : infos)
+	{
+		const auto& arg_info = info.second;
+		ArgHelpRow row;
+		row.full_name = arg_info.GetFullName();
+		row.short_name = arg_info.GetShortName();
+		row.help = arg_info.GetHelp();
+		row.has_value = arg_info.HasValue();
+		row.has_default = row.has_value && arg_info.GetValue().HasDefaultValue();
+		if (row.has_default)
+		{
+			default_value = arg_info.GetValue().GetStringDefaultValue();
+			row.default_value = default_value;
+		}
+		WriteOptionHelp(output, row, max_size_arg_help_desc, max_size_arg_help_info);
+	}
+}
+
+template<typename Output>
+void WriteHelpHeader(
+	Output& output,
+	std::string_view program_name,
+	std::string_view description,
+	size_t options_size)
+{
+	constexpr std::string_view usage = "Usage: ";
+	constexpr std::string_view options = " [options]\n";
+	constexpr std::string_view available_options = "Available options:\n";
+
+	output.Reserve(
+		usage.size() + program_name.size() + options.size()
+		+ description.size() + 1 + available_options.size() + options_size);
+
+	output.Write(usage);
+	output.Write(program_name);
+	output.Write(options);
+	if (!description.empty())
+	{
+		output.Write(description);
+		output.Write("\n");
+	}
+	output.Write(available_options);
+}
+
+template<typename Output>
+void WriteHelpImpl(
+	Output& output,
+	std::string_view program_name,
+	const ArgsInitializer& args_infos)
+{
+	const auto& layout = args_infos.GetHelpLayout();
+	WriteHelpHeader(output, program_name, args_infos.GetDescription(), layout.GetText().size());
+
+	if (!layout.Empty())
+	{
+		output.Write(layout.GetText());
+		return;
+	}
+	WriteOptionsHelp(
+		output,
+		args_infos.GetArgsInfos(),
+		args_infos.GetMaxSizeArgHelpDesc(),
+		args_infos.GetMaxSizeArgHelpInfo());
+}
+
+} // namespace
+
+ArgsHelpLayout::ArgsHelpLayout(std::pmr::memory_resource* resource)
+	: text_(resource)
+{}
+
+void ArgsHelpLayout::Build(
+	const ArgsInfosMap& infos,
+	size_t max_size_arg_help_desc,
+	size_t max_size_arg_help_info)
+{
+	text_.clear();
+	StringOutput<std::pmr::string> output(text_);
+	WriteOptionsHelp(output, infos, max_size_arg_help_desc, max_size_arg_help_info);
+	text_.shrink_to_fit();
+	built_ = true;
+}
+
+bool ArgsHelpLayout::Empty() const
+{
+	return !built_;
+}
+
+std::string_view ArgsHelpLayout::GetText() const
+{
+	return text_;
+}
+
+void ArgsHelpLayout::Write(
+	std::ostream& stream,
+	const ArgsInfosMap& infos,
+	size_t max_size_arg_help_desc,
+	size_t max_size_arg_help_info)
+{
+	StreamOutput output(stream);
+	WriteOptionsHelp(output, infos, max_size_arg_help_desc, max_size_arg_help_info);
+}
+
+void ArgsHelpLayout::Write(
+	std::string& buffer,
+	const ArgsInfosMap& infos,
+	size_t max_size_arg_help_desc,
+	size_t max_size_arg_help_info)
+{
+	StringOutput<std::string> output(buffer);
+	WriteOptionsHelp(output, infos, max_size_arg_help_desc, max_size_arg_help_info);
+}
+
+void WriteHelp(
+	std::ostream& stream,
+	std::string_view program_name,
+	const ArgsInitializer& args_infos)
+{
+	StreamOutput output(stream);
+	WriteHelpImpl(output, program_name, args_infos);
+}
+
+void AppendHelp(
+	std::string& buffer,
+	std::string_view program_name,
+	const ArgsInitializer& args_infos)
+{
+	StringOutput<std::string> output(buffer);
+	WriteHelpImpl(output, program_name, args_infos);
+}
+
+std::string GetHelpString(
+	std::string_view program_name,
+	const ArgsInitializer& args_infos)
+{
+	std::string result;
+	AppendHelp(result, program_name, args_infos);
+	return result;
+}
+
+void AppendHelpHeader(
+	std::string& buffer,
+	std::string_view program_name,
+	std::string_view description,
+	size_t options_size)
+{
+	StringOutput<std::string> output(buffer);
+	WriteHelpHeader(output, program_name, description, options_size);
+}
+
+void AppendOptionHelp(
+	std::string& buffer,
+	const ArgHelpRow& row,
+	size_t max_size_arg_help_desc,
+	size_t max_size_arg_help_info)
+{
+	StringOutput<std::string> output(buffer);
+	WriteOptionHelp(output, row, max_size_arg_help_desc, max_size_arg_help_info);
+}
+
+} // namespace SimpleArgsParser
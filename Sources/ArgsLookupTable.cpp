@@ -0,0 +1,71 @@
+#include "../Headers/ArgsLookupTable.h"
+
+namespace SimpleArgsParser
+{
+
+ArgsLookupTable::ArgsLookupTable(std::pmr::memory_resource* resource)
+	: slots_(resource)
+{}
+
+void ArgsLookupTable::Build(const std::pmr::vector<std::pair<std::string_view, size_t>>& names)
+{
+	// Keep load factor <= 0.5 so probe sequences stay short.
+	size_t capacity = 8;
+	while (capacity < names.size() * 2)
+	{
+		capacity *= 2;
+	}
+
+	slots_.assign(capacity, Slot());
+	mask_ = capacity - 1;
+	for (const auto& [name, index] : names)
+	{
+		const auto hash = Hash(name);
+		auto pos = static_cast<size_t>(hash) & mask_;
+		while (slots_[pos].index != npos)
+		{
+			pos = (pos + 1) & mask_;
+		}
+		slots_[pos] = Slot{ name, hash, index };
+	}
+}
+
+size_t ArgsLookupTable::Find(std::string_view name) const
+{
+	if (slots_.empty())
+	{
+		return npos;
+	}
+
+	const auto hash = Hash(name);
+	auto pos = static_cast<size_t>(hash) & mask_;
+	while (slots_[pos].index != npos)
+	{
+		const auto& slot = slots_[pos];
+		if (slot.hash == hash && slot.name == name)
+		{
+			return slot.index;
+		}
+		pos = (pos + 1) & mask_;
+	}
+	return npos;
+}
+
+bool ArgsLookupTable::Empty() const
+{
+	return slots_.empty();
+}
+
+uint64_t ArgsLookupTable::Hash(std::string_view name)
+{
+	// FNV-1a, names are short so it's cheaper than std::hash here.
+	uint64_t hash = 14695981039346656037ull;
+	for (const auto symbol : name)
+	{
+		hash ^= static_cast<unsigned char>(symbol);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,262 @@
+#include "../Headers/ArgsNameTrie.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace SimpleArgsParser
+{
+
+ArgsNameTrie::ArgsNameTrie(std::pmr::memory_resource* resource)
+	: names_(resource)
+	, nodes_(resource)
+	, labels_(resource)
+{}
+
+void ArgsNameTrie::Build(const std::pmr::vector<std::pair<std::string_view, size_t>>& names)
+{
+	names_.assign(names.cbegin(), names.cend());
+	std::sort(names_.begin(), names_.end());
+
+	max_name_size_ = 0;
+	size_t labels_size = 0;
+	for (const auto& [name, index] : names_)
+	{
+		max_name_size_ = std::max(max_name_size_, name.size());
+		labels_size += name.size();
+	}
+
+	nodes_.clear();
+	nodes_.reserve(names_.size() * 2 + 1);
+	labels_.clear();
+	labels_.reserve(labels_size);
+	nodes_.emplace_back();
+	if (!names_.empty())
+	{
+		BuildNode(0, names_.cbegin(), names_.cend(), 0);
+	}
+}
+
+size_t ArgsNameTrie::Find(std::string_view name) const
+{
+	const auto node = FindPrefixNode(name);
+	if (node == npos)
+	{
+		return npos;
+	}
+	// The prefix node may be reached in the middle of its label.
+	const auto name_pos = nodes_[node].name;
+	if (name_pos == npos || names_[name_pos].first.size() != name.size())
+	{
+		return npos;
+	}
+	return names_[name_pos].second;
+}
+
+size_t ArgsNameTrie::FindByPrefix(std::string_view prefix) const
+{
+	const auto node = FindPrefixNode(prefix);
+	if (node == npos)
+	{
+		return npos;
+	}
+	const auto subtree_name = nodes_[node].subtree_name;
+	return subtree_name == ambiguous || subtree_name == npos ? subtree_name : names_[subtree_name].second;
+}
+
+std::vector<std::string_view> ArgsNameTrie::CollectByPrefix(std::string_view prefix, size_t max_count) const
+{
+	std::vector<std::string_view> result;
+	const auto node = FindPrefixNode(prefix);
+	if (node != npos)
+	{
+		Collect(node, max_count, result);
+	}
+	return result;
+}
+
+std::vector<std::string_view> ArgsNameTrie::FindSimilar(
+	std::string_view name,
+	size_t max_distance,
+	size_t max_count) const
+{
+	std::vector<std::string_view> result;
+	if (names_.empty() || max_count == 0)
+	{
+		return result;
+	}
+
+	// Row of edit distances between the name and trie path of each depth.
+	const auto row_size = name.size() + 1;
+	std::vector<size_t> rows((max_name_size_ + 1) * row_size);
+	for (size_t i = 0; i < row_size; ++i)
+	{
+		rows[i] = i;
+	}
+
+	std::vector<std::tuple<size_t, std::string_view>> candidates;
+	// Siblings only overwrite rows below their parent depth, so depth first
+	// traversal keeps rows of all ancestors valid.
+	std::vector<std::pair<size_t, size_t>> stack;
+	const auto& root = nodes_.front();
+	for (uint32_t i = 0; i < root.children_count; ++i)
+	{
+		stack.emplace_back(root.children_begin + i, 0);
+	}
+
+	while (!stack.empty())
+	{
+		const auto [node_index, parent_depth] = stack.back();
+		stack.pop_back();
+		const auto& node = nodes_[node_index];
+
+		auto depth = parent_depth;
+		bool pruned = false;
+		for (const char symbol : GetLabel(node))
+		{
+			const size_t* previous = &rows[depth * row_size];
+			size_t* current = &rows[(depth + 1) * row_size];
+			current[0] = depth + 1;
+			auto row_min = current[0];
+			for (size_t j = 1; j < row_size; ++j)
+			{
+				current[j] = std::min({
+					previous[j] + 1,
+					current[j - 1] + 1,
+					previous[j - 1] + (name[j - 1] == symbol ? 0 : 1) });
+				row_min = std::min(row_min, current[j]);
+			}
+			++depth;
+			if (row_min > max_distance)
+			{
+				pruned = true;
+				break;
+			}
+		}
+		if (pruned)
+		{
+			continue;
+		}
+
+		if (node.name != npos && rows[depth * row_size + name.size()] <= max_distance)
+		{
+			candidates.emplace_back(rows[depth * row_size + name.size()], names_[node.name].first);
+		}
+		for (uint32_t i = 0; i < node.children_count; ++i)
+		{
+			stack.emplace_back(node.children_begin + i, depth);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	for (size_t i = 0; i < candidates.size() && i < max_count; ++i)
+	{
+		result.push_back(std::get<1>(candidates[i]));
+	}
+	return result;
+}
+
+void ArgsNameTrie::BuildNode(size_t node, NamesIterator begin, NamesIterator end, size_t depth)
+{
+	nodes_[node].subtree_name = end - begin == 1 ? static_cast<size_t>(begin - names_.cbegin()) : ambiguous;
+	// Names are sorted, so the name which ends in the node goes first.
+	if (begin->first.size() == depth)
+	{
+		nodes_[node].name = static_cast<size_t>(begin - names_.cbegin());
+		++begin;
+	}
+
+	size_t children_count = 0;
+	for (auto it = begin; it != end; ++children_count)
+	{
+		const auto symbol = it->first[depth];
+		it = std::find_if(it, end, [depth, symbol](const auto& name) { return name.first[depth] != symbol; });
+	}
+
+	const auto children_begin = nodes_.size();
+	nodes_[node].children_begin = static_cast<uint32_t>(children_begin);
+	nodes_[node].children_count = static_cast<uint32_t>(children_count);
+	nodes_.resize(children_begin + children_count);
+
+	auto child = children_begin;
+	for (auto it = begin; it != end; ++child)
+	{
+		const auto symbol = it->first[depth];
+		const auto group_end = std::find_if(it, end, [depth, symbol](const auto& name) { return name.first[depth] != symbol; });
+
+		// Common prefix of a sorted group is the common prefix of its first and last names.
+		const auto first = it->first;
+		const auto last = std::prev(group_end)->first;
+		auto label_end = depth + 1;
+		while (label_end < first.size() && label_end < last.size() && first[label_end] == last[label_end])
+		{
+			++label_end;
+		}
+
+		nodes_[child].label_begin = static_cast<uint32_t>(labels_.size());
+		nodes_[child].label_size = static_cast<uint32_t>(label_end - depth);
+		labels_.insert(labels_.end(), first.begin() + static_cast<std::ptrdiff_t>(depth), first.begin() + static_cast<std::ptrdiff_t>(label_end));
+
+		BuildNode(child, it, group_end, label_end);
+		it = group_end;
+	}
+}
+
+size_t ArgsNameTrie::FindPrefixNode(std::string_view prefix) const
+{
+	if (nodes_.empty())
+	{
+		return npos;
+	}
+
+	size_t node = 0;
+	while (!prefix.empty())
+	{
+		const auto& current = nodes_[node];
+		const auto children_begin = nodes_.cbegin() + current.children_begin;
+		const auto children_end = children_begin + current.children_count;
+		// Children are sorted by the first symbol of their labels.
+		const auto child = std::lower_bound(
+			children_begin,
+			children_end,
+			prefix.front(),
+			[this](const Node& child_node, char symbol) { return labels_[child_node.label_begin] < symbol; });
+		if (child == children_end || labels_[child->label_begin] != prefix.front())
+		{
+			return npos;
+		}
+
+		const auto label = GetLabel(*child);
+		const auto size = std::min(label.size(), prefix.size());
+		if (label.substr(0, size) != prefix.substr(0, size))
+		{
+			return npos;
+		}
+		prefix.remove_prefix(size);
+		node = static_cast<size_t>(child - nodes_.cbegin());
+	}
+	return node;
+}
+
+void ArgsNameTrie::Collect(size_t node, size_t max_count, std::vector<std::string_view>& result) const
+{
+	if (result.size() >= max_count)
+	{
+		return;
+	}
+	const auto& current = nodes_[node];
+	if (current.name != npos)
+	{
+		result.push_back(names_[current.name].first);
+	}
+	for (uint32_t i = 0; i < current.children_count; ++i)
+	{
+		Collect(current.children_begin + i, max_count, result);
+	}
+}
+
+std::string_view ArgsNameTrie::GetLabel(const Node& node) const
+{
+	return std::string_view(labels_.data() + node.label_begin, node.label_size);
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,195 @@
+#include "../Headers/ArgsParseError.h"
+#include "../Headers/ArgsParser.h"
+
+namespace SimpleArgsParser
+{
+
+ArgsParseError::ArgsParseError(
+	ArgsErrorCode code,
+	size_t argv_index,
+	std::string_view token,
+	std::string details)
+	: code_(code)
+	, argv_index_(argv_index)
+	, token_(token)
+	, details_(std::move(details))
+{}
+
+ArgsErrorCode ArgsParseError::GetCode() const
+{
+	return code_;
+}
+
+size_t ArgsParseError::GetArgvIndex() const
+{
+	return argv_index_;
+}
+
+std::string_view ArgsParseError::GetToken() const
+{
+	return token_;
+}
+
+std::string ArgsParseError::GetMessage() const
+{
+	if (!details_.empty())
+	{
+		return details_;
+	}
+
+	switch (code_)
+	{
+	case ArgsErrorCode::None:
+		return "";
+	case ArgsErrorCode::IncorrectArgc:
+		return "Incorrect value of argc param.";
+	case ArgsErrorCode::IncorrectArgv:
+		return "Incorrect value of argv param.";
+	case ArgsErrorCode::UnknownParam:
+		if (token_.empty())
+		{
+			return "Unknown empty param.";
+		}
+		return "Unknown param: " + std::string(token_) + ".";
+	case ArgsErrorCode::AmbiguousParam:
+		return "Ambiguous param: " + std::string(token_) + ".";
+	case ArgsErrorCode::MissingParamValue:
+		return "Please set param value: " + std::string(token_) + ".";
+	case ArgsErrorCode::IncorrectValue:
+		return "Incorrect value: " + std::string(token_) + ".";
+	case ArgsErrorCode::ValueOutOfRange:
+		return "Value out of range.";
+	case ArgsErrorCode::RequiredParamNotSet:
+		if (GetParamIndexes().size() > 1)
+		{
+			return "Please set required params " + JoinParams(0) + ".";
+		}
+		return "Please set required param " + std::string(token_) + ".";
+	case ArgsErrorCode::ResponseFileNotRead:
+		return "Can't read response file: " + std::string(token_) + ".";
+	case ArgsErrorCode::RecursiveResponseFile:
+		return "Recursive response file: " + std::string(token_) + ".";
+	case ArgsErrorCode::ResponseFilesTooDeep:
+		return "Too deep nesting of response files: " + std::string(token_) + ".";
+	case ArgsErrorCode::IncorrectResponseFile:
+		return "Unterminated quote in response file: " + std::string(token_) + ".";
+	case ArgsErrorCode::ConfigFileNotRead:
+		return "Can't read config file: " + std::string(token_) + ".";
+	case ArgsErrorCode::IncorrectConfigFile:
+		return "Incorrect config file: " + std::string(token_) + ".";
+	case ArgsErrorCode::UnknownSubcommand:
+		return "Unknown command: " + std::string(token_) + ".";
+	case ArgsErrorCode::ConflictingParams:
+		return "Params can't be set together: " + JoinParams(0) + ".";
+	case ArgsErrorCode::GroupParamNotSet:
+		return "Please set one of params " + JoinParams(0) + ".";
+	case ArgsErrorCode::DependentParamNotSet:
+		return "Param " + std::string(token_) + " requires " + JoinParams(1) + ".";
+	case ArgsErrorCode::BindObjectTypeMismatch:
+		return "Options are bound to members of another type.";
+	case ArgsErrorCode::InternalError:
+		return "Internal error.";
+	}
+	return "Unknown error.";
+}
+
+std::vector<std::string_view> ArgsParseError::GetSuggestions(size_t max_count) const
+{
+	if (initializer_ == nullptr || token_.empty())
+	{
+		return {};
+	}
+	if (code_ == ArgsErrorCode::UnknownParam)
+	{
+		return initializer_->FindSimilarNames(token_, max_count);
+	}
+	if (code_ == ArgsErrorCode::AmbiguousParam)
+	{
+		return initializer_->FindNamesByPrefix(token_, max_count);
+	}
+	return {};
+}
+
+void ArgsParseError::SetInitializer(const ArgsInitializer& initializer)
+{
+	initializer_ = &initializer;
+}
+
+void ArgsParseError::DetachToken()
+{
+	if (token_storage_ != nullptr)
+	{
+		return;
+	}
+	token_storage_ = std::make_shared<const std::string>(token_);
+	token_ = *token_storage_;
+}
+
+const std::vector<size_t>& ArgsParseError::GetParamIndexes() const
+{
+	static const std::vector<size_t> empty;
+	return param_indexes_ == nullptr ? empty : *param_indexes_;
+}
+
+std::vector<std::string> ArgsParseError::GetParams() const
+{
+	std::vector<std::string> result;
+	const auto& indexes = GetParamIndexes();
+	result.reserve(indexes.size());
+	for (const auto index : indexes)
+	{
+		result.push_back(GetParamName(index));
+	}
+	return result;
+}
+
+std::string ArgsParseError::GetParamName(size_t index) const
+{
+	const auto name = param_name_resolver_(params_schema_, index);
+	std::string result;
+	result.reserve(param_name_prefix_.size() + name.size());
+	result.append(param_name_prefix_).append(name);
+	return result;
+}
+
+std::string ArgsParseError::JoinParams(size_t first) const
+{
+	std::string result;
+	const auto& indexes = GetParamIndexes();
+	for (size_t i = first; i < indexes.size(); ++i)
+	{
+		result += i == first ? "" : ", ";
+		result += param_name_prefix_;
+		result += param_name_resolver_(params_schema_, indexes[i]);
+	}
+	return result;
+}
+
+void ArgsParseError::SetParams(
+	std::vector<size_t> indexes,
+	const void* schema,
+	ParamNameResolver resolver,
+	std::string_view name_prefix)
+{
+	param_indexes_ = std::make_shared<const std::vector<size_t>>(std::move(indexes));
+	params_schema_ = schema;
+	param_name_resolver_ = resolver;
+	param_name_prefix_ = name_prefix;
+	token_storage_ = nullptr;
+	if (param_indexes_->empty())
+	{
+		token_ = {};
+	}
+	else if (name_prefix.empty())
+	{
+		// The name is owned by the schema, no copy is needed.
+		token_ = resolver(schema, param_indexes_->front());
+	}
+	else
+	{
+		token_storage_ = std::make_shared<const std::string>(GetParamName(param_indexes_->front()));
+		token_ = *token_storage_;
+	}
+}
+
+} // namespace SimpleArgsParser
@@ -1,8 +1,10 @@
 #include "../Headers/ArgsParser.h"
+#include "../Headers/ArgsExternalValues.h"
+#include "../Headers/ArgsResponseFiles.h"
+#include "../Headers/ArgsTokenParser.h"
 
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
+#include <any>
 
 namespace SimpleArgsParser
 {
@@ -10,153 +12,377 @@ namespace SimpleArgsParser
 namespace
 {
 
-std::string GetHelpString(
-	const std::string& program_name,
-	const ArgsInitializer& args_infos)
+constexpr std::string_view help_full_name = "--help";
+constexpr std::string_view help_short_name = "-h";
+
+bool StartsWith(std::string_view value, std::string_view prefix)
+{
+	return value.substr(0, prefix.size()) == prefix;
+}
+
+// Resolves param names of errors, the names are owned by the initializer.
+std::string_view GetOptionFullName(const void* initializer, size_t index)
 {
-	std::ostringstream result;
-	result << "Usage: " << program_name << " [options]\n";
+	return static_cast<const ArgsInitializer*>(initializer)->GetArgInfosByIndex(index).GetFullName();
+}
 
-	if (const auto& desc = args_infos.GetDescription(); !desc.empty())
+size_t GetEditDistance(std::string_view left, std::string_view right)
+{
+	std::vector<size_t> row(right.size() + 1);
+	for (size_t j = 0; j < row.size(); ++j)
+	{
+		row[j] = j;
+	}
+	for (size_t i = 1; i <= left.size(); ++i)
 	{
-		result << desc << "\n";
+		auto diagonal = row[0];
+		row[0] = i;
+		for (size_t j = 1; j <= right.size(); ++j)
+		{
+			const auto above = row[j];
+			row[j] = std::min({ above + 1, row[j - 1] + 1, diagonal + (left[i - 1] == right[j - 1] ? 0 : 1) });
+			diagonal = above;
+		}
 	}
+	return row.back();
+}
+
+// Longer names allow more typos.
+size_t GetMaxSuggestionDistance(std::string_view name)
+{
+	const auto size = name.size() - std::min(name.find_first_not_of('-'), name.size());
+	return size <= 4 ? 1 : (size <= 8 ? 2 : 3);
+}
+
+// Tokens of argv with expanded response files.
+class ViewTokens
+{
 
-	const auto& infos = args_infos.GetArgsInfos();
-	const auto max_size_arg_help_desc = args_infos.GetMaxSizeArgHelpDesc();
-	const auto max_size_arg_help_info = args_infos.GetMaxSizeArgHelpInfo();
+public:
+	static constexpr bool outlive_parse = false;
 
-	result << "Available options:\n";
+	explicit ViewTokens(const std::pmr::vector<std::string_view>& tokens)
+		: tokens_(tokens)
+	{}
 
-	for (const auto& info : infos)
+	size_t Size() const
 	{
-		const auto& arg_info = info.second;
-		std::string arg_string = "  " + arg_info.GetFullName();
+		return tokens_.size();
+	}
 
-		if (!arg_info.GetShortName().empty())
-		{
-			arg_string += "," + arg_info.GetShortName();
-		}
+	bool Get(size_t index, std::string_view& token) const
+	{
+		token = tokens_[index];
+		return true;
+	}
+
+private:
+	const std::pmr::vector<std::string_view>& tokens_;
+};
+
+// How InitializerOptions stores values of lazy conversion.
+enum class RawValueMode
+{
+	Convert,
+	Keep,
+	Copy
+};
+
+ArgsParseError MakeValueError(ConvertStatus status, size_t argv_index, std::string_view value, std::string error)
+{
+	return ArgsParseError(
+		status == ConvertStatus::OutOfRange ? ArgsErrorCode::ValueOutOfRange : ArgsErrorCode::IncorrectValue,
+		argv_index,
+		value,
+		std::move(error));
+}
 
-		if (arg_info.HasValue())
+// Options of the initializer for ParseOptionTokens, values are put to the store.
+class InitializerOptions
+{
+
+public:
+	InitializerOptions(
+		const ArgsInitializer& argument_initializer,
+		ArgsValueStore& filled_options,
+		RawValueMode raw_mode,
+		std::string_view program_name,
+		std::string& help)
+		: argument_initializer_(argument_initializer)
+		, filled_options_(filled_options)
+		, raw_mode_(raw_mode)
+		, program_name_(program_name)
+		, help_(help)
+	{}
+
+	// Exact name first, then unambiguous abbreviation if it's enabled.
+	size_t Find(std::string_view name, ArgsErrorCode& code) const
+	{
+		const auto* arg_info = argument_initializer_.FindArgInfos(name);
+		if (arg_info == nullptr && argument_initializer_.IsAbbreviationsEnabled())
 		{
-			arg_string += " arg";
-			if (arg_info.GetValue().HasDefaultValue())
+			bool ambiguous = false;
+			arg_info = argument_initializer_.FindArgInfosByPrefix(name, ambiguous);
+			if (ambiguous)
 			{
-				arg_string += "(=" + arg_info.GetValue().GetStringDefaultValue() + ")";
+				code = ArgsErrorCode::AmbiguousParam;
+				return unknown_option;
 			}
 		}
+		code = arg_info == nullptr ? ArgsErrorCode::UnknownParam : ArgsErrorCode::None;
+		return arg_info == nullptr ? unknown_option : arg_info->GetIndex();
+	}
 
-		if (arg_string.size() + 1 > max_size_arg_help_desc)
-		{
-			result << arg_string << "\n";
-			result << std::setw(max_size_arg_help_desc) << "";
-		}
-		else
-		{
-			result << arg_string << std::setw(max_size_arg_help_desc - arg_string.size()) << "";
-		}
+	size_t FindShort(std::string_view name) const
+	{
+		const auto* arg_info = argument_initializer_.FindArgInfos(name);
+		return arg_info == nullptr ? unknown_option : arg_info->GetIndex();
+	}
+
+	bool HasValue(size_t index) const
+	{
+		return argument_initializer_.GetArgInfosByIndex(index).HasValue();
+	}
+
+	bool IsMultiValued(size_t index) const
+	{
+		return argument_initializer_.GetArgInfosByIndex(index).GetValue().IsMultiValued();
+	}
 
-		const auto& help = arg_info.GetHelp();
-		size_t prev_local_pos = 0;
-		size_t start_line_pos = 0;
+	bool IsSet(size_t index) const
+	{
+		return filled_options_.Has(index);
+	}
 
-		auto pos = help.find(' ', start_line_pos + 1);
-		while (pos != std::string::npos)
+	void SetFlag(size_t index)
+	{
+		filled_options_.Set(index, true);
+	}
+
+	ArgsParseError Store(size_t index, std::string_view value, size_t argv_index)
+	{
+		const auto& arg_value = argument_initializer_.GetArgInfosByIndex(index).GetValue();
+		// Bound values are converted into their variables right away.
+		const auto bound = filled_options_.IsBindingEnabled() && arg_value.IsBound();
+		if (raw_mode_ != RawValueMode::Convert && !arg_value.IsMultiValued() && !bound)
 		{
-			if (pos > start_line_pos + max_size_arg_help_info)
+			if (raw_mode_ == RawValueMode::Keep)
 			{
-				if (start_line_pos != 0)
-				{
-					result << std::setw(max_size_arg_help_desc) << "";
-				}
-				if (prev_local_pos == 0)
-				{
-					result << help.substr(start_line_pos, pos - start_line_pos) << "\n";
-					start_line_pos = pos + 1;
-					pos = help.find(' ', start_line_pos);
-				}
-				else
-				{
-					result << help.substr(start_line_pos, prev_local_pos) << "\n";
-					start_line_pos += prev_local_pos + 1;
-					prev_local_pos = 0;
-				}
+				filled_options_.SetRaw(index, value);
 			}
 			else
 			{
-				prev_local_pos = pos - start_line_pos;
-				pos = help.find(' ', pos + 1);
+				filled_options_.SetRawCopy(index, value);
 			}
+			return ArgsParseError();
 		}
-
-		if (help.size() > start_line_pos)
+		const auto status = arg_value.ParseInto(value, filled_options_, index, error_);
+		if (status != ConvertStatus::Ok)
 		{
-			if (start_line_pos != 0)
-			{
-				result << std::setw(max_size_arg_help_desc) << "";
-			}
-			if (help.size() > max_size_arg_help_info + start_line_pos && prev_local_pos != 0)
-			{
-				result << help.substr(start_line_pos, prev_local_pos) << "\n";
-				start_line_pos += prev_local_pos + 1;
-				prev_local_pos = 0;
-				if (help.size() > start_line_pos)
-				{
-					result << std::setw(max_size_arg_help_desc) << "";
-					result << help.substr(start_line_pos, help.size() - start_line_pos) << "\n";
-				}
-			}
-			else
-			{
-				result << help.substr(start_line_pos, help.size() - start_line_pos) << "\n";
-			}
+			return MakeValueError(status, argv_index, value, std::move(error_));
 		}
+		return ArgsParseError();
+	}
+
+	ArgsParseError MakeOptionError(ArgsErrorCode code, size_t argv_index, std::string_view token) const
+	{
+		ArgsParseError result(code, argv_index, token);
+		result.SetInitializer(argument_initializer_);
+		return result;
 	}
-	return result.str();
-}
 
-std::pair<std::string, std::string> SplitOptionName(std::string value)
+	// Help is rendered only when it's requested on the command line or read from the container.
+	void OnHelp()
+	{
+		help_ = GetHelpString(program_name_, argument_initializer_);
+	}
+
+private:
+	const ArgsInitializer& argument_initializer_;
+	ArgsValueStore& filled_options_;
+	RawValueMode raw_mode_;
+	std::string_view program_name_;
+	std::string& help_;
+	// Error message of user value converter.
+	std::string error_;
+};
+
+// If positional_index is set, parse stops at the first token which is neither
+// an option nor its value, index of the token (or size of tokens) is stored there.
+template<typename Tokens>
+ArgsParseError ParseTokens(
+	const Tokens& tokens,
+	std::string_view program_name,
+	const ArgsInitializer& argument_initializer,
+	ArgsValueStore& filled_options,
+	std::string& help,
+	std::pmr::memory_resource* resource,
+	size_t* positional_index = nullptr)
 {
-	if (value.empty())
+	auto raw_mode = RawValueMode::Convert;
+	if (argument_initializer.GetConversion() == ArgsConversion::Lazy)
 	{
-		throw ArgsParserException("Empty option name.");
+		raw_mode = Tokens::outlive_parse ? RawValueMode::Keep : RawValueMode::Copy;
 	}
-	if (value.front() == '-')
+
+	InitializerOptions options(argument_initializer, filled_options, raw_mode, program_name, help);
+	if (auto error = ParseOptionTokens(tokens, options, positional_index); error.GetCode() != ArgsErrorCode::None)
 	{
-		throw ArgsParserException("Incorrect full option name (please remove '-') " + value + ".");
+		return error;
 	}
-	value.erase(std::remove(value.begin(), value.end(), ' '), value.end());
-	const auto pos = value.find(',');
-	if (pos != std::string::npos)
+
+	// Options which aren't set in argv are taken from the environment, then from the config file.
+	std::shared_ptr<const ArgsExternalValues> external_values;
+	if (argument_initializer.HasEnvOptions() || argument_initializer.HasConfigOptions())
 	{
-		if (pos == 0)
+		external_values = argument_initializer.GetExternalValues(resource);
+		if (external_values->GetError().GetCode() != ArgsErrorCode::None)
 		{
-			throw ArgsParserException("Empty full option name.");
+			return external_values->GetError();
 		}
-		const auto full_name = value.substr(0, pos);
-		const auto short_name = value.substr(pos + 1);
-		if (short_name.empty())
+	}
+
+	// Only the words of bound and required options which aren't set are
+	// visited. Defaults aren't stored, containers read them from the initializer.
+	ArgsParseError external_error;
+	if (external_values != nullptr)
+	{
+		// Values are copied, the snapshot can be released before they are read.
+		InitializerOptions external_options(
+			argument_initializer,
+			filled_options,
+			raw_mode == RawValueMode::Convert ? RawValueMode::Convert : RawValueMode::Copy,
+			program_name,
+			help);
+		argument_initializer.GetExternalOptions().ForEachNotIn(
+			filled_options.GetFilled(),
+			[&](size_t index)
+			{
+				if (!external_values->Has(index))
+				{
+					return true;
+				}
+				external_error = StoreOptionValue(external_options, index, external_values->Get(index), ArgsParseError::npos);
+				return external_error.GetCode() == ArgsErrorCode::None;
+			});
+		if (external_error.GetCode() != ArgsErrorCode::None)
 		{
-			throw ArgsParserException("Empty short option name.");
+			// Value refers to the snapshot of the environment and the config file,
+			// which is released on refresh.
+			external_error.DetachToken();
+			return external_error;
 		}
-		if (short_name.front() == '-')
+	}
+
+	std::vector<size_t> missing_params;
+	argument_initializer.GetRequiredOptions().ForEachNotIn(
+		filled_options.GetFilled(),
+		[&](size_t index)
 		{
-			throw ArgsParserException("Incorrect short option name (please remove '-') " + short_name + ".");
-		}
-		return std::make_pair("--" + full_name, "-" + short_name);
+			missing_params.push_back(index);
+			return true;
+		});
+	if (!missing_params.empty())
+	{
+		ArgsParseError required_error(ArgsErrorCode::RequiredParamNotSet);
+		required_error.SetParams(std::move(missing_params), &argument_initializer, &GetOptionFullName);
+		return required_error;
+	}
+	if (auto group_error = argument_initializer.CheckGroups(filled_options.GetFilled());
+		group_error.GetCode() != ArgsErrorCode::None)
+	{
+		return group_error;
+	}
+
+	// Bound variables get the defaults, as they aren't read through a container.
+	// Containers read defaults from the initializer and never write to variables.
+	if (!filled_options.IsBindingEnabled())
+	{
+		return ArgsParseError();
 	}
-	return std::make_pair("--" + value, "");
+	argument_initializer.GetBoundOptions().ForEachNotIn(
+		filled_options.GetFilled(),
+		[&](size_t index)
+		{
+			const auto& value = argument_initializer.GetArgInfosByIndex(index).GetValue();
+			if (value.HasDefaultValue())
+			{
+				value.SetDefaultTo(filled_options.GetBindObject());
+			}
+			return true;
+		});
+	return ArgsParseError();
 }
 
-} // namespace
+// Parses argv, with expanded response files if they are enabled, into the store.
+ArgsParseError ParseArgv(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	ArgsValueStore& filled_options,
+	std::string& help,
+	std::pmr::memory_resource* resource)
+{
+	if (argc <= 0)
+	{
+		return ArgsParseError(ArgsErrorCode::IncorrectArgc);
+	}
+	if (argv == nullptr)
+	{
+		return ArgsParseError(ArgsErrorCode::IncorrectArgv);
+	}
 
+	const auto u_argc = static_cast<size_t>(argc);
+	if (!argument_initializer.IsResponseFilesEnabled())
+	{
+		return ParseTokens(ArgvTokens(u_argc, argv), argv[0], argument_initializer, filled_options, help, resource);
+	}
+
+	ArgsResponseFiles response_files(resource);
+	auto error = response_files.Expand(u_argc, argv);
+	if (error.GetCode() == ArgsErrorCode::None)
+	{
+		error = ParseTokens(
+			ViewTokens(response_files.GetTokens()),
+			argv[0],
+			argument_initializer,
+			filled_options,
+			help,
+			resource);
+	}
+	// Error token may refer to the files, which are unmapped on return.
+	if (error.GetCode() != ArgsErrorCode::None)
+	{
+		error.DetachToken();
+	}
+	return error;
+}
+
+} // namespace
 
 ArgsInitializer::ArgsInitializer(
-	std::string description,
+	std::string_view description,
 	size_t max_size_arg_help_desc,
-	size_t max_size_arg_help_info)
-	: description_(std::move(description))
+	size_t max_size_arg_help_info,
+	std::pmr::memory_resource* resource)
+	: resource_(resource)
+	, args_infos_(resource)
+	, short_to_full_name_(resource)
+	, indexed_args_infos_(resource)
+	, env_name_to_index_(resource)
+	, config_key_to_index_(resource)
+	, lookup_table_(resource)
+	, name_trie_(resource)
+	, env_table_(resource)
+	, config_table_(resource)
+	, help_layout_(resource)
+	, defaults_(0, resource)
+	, required_options_(0, resource)
+	, external_options_(0, resource)
+	, bound_options_(0, resource)
+	, groups_(resource)
+	, config_file_(resource)
+	, description_(description, resource)
 	, max_size_arg_help_desc_(max_size_arg_help_desc)
 	, max_size_arg_help_info_(max_size_arg_help_info)
 {
@@ -178,40 +404,426 @@ ArgsInitializer& ArgsInitializer::operator()(
 	AddArg(
 		std::move(option_name),
 		std::move(help),
-		nullptr,
+		ArgValuePtr(),
 		std::move(arg_options));
 	return *this;
 }
 
-const ArgInfos& ArgsInitializer::GetArgInfos(std::string value) const
+void ArgsInitializer::Freeze()
+{
+	if (frozen_)
+	{
+		return;
+	}
+
+	std::pmr::vector<std::pair<std::string_view, size_t>> names(resource_);
+	names.reserve(indexed_args_infos_.size() + short_to_full_name_.size());
+	for (const auto* arg_info : indexed_args_infos_)
+	{
+		names.emplace_back(arg_info->GetFullName(), arg_info->GetIndex());
+		if (!arg_info->GetShortName().empty())
+		{
+			names.emplace_back(arg_info->GetShortName(), arg_info->GetIndex());
+		}
+	}
+	lookup_table_.Build(names);
+	name_trie_.Build(names);
+
+	const auto build_table = [this](ArgsLookupTable& table, const auto& name_to_index)
+	{
+		std::pmr::vector<std::pair<std::string_view, size_t>> table_names(resource_);
+		table_names.reserve(name_to_index.size());
+		for (const auto& [name, index] : name_to_index)
+		{
+			table_names.emplace_back(name, index);
+		}
+		table.Build(table_names);
+	};
+	build_table(env_table_, env_name_to_index_);
+	build_table(config_table_, config_key_to_index_);
+
+	help_layout_.Build(args_infos_, max_size_arg_help_desc_, max_size_arg_help_info_);
+	if (HasEnvOptions() || HasConfigOptions())
+	{
+		external_values_ = std::make_unique<ExternalValuesCache>();
+	}
+	frozen_ = true;
+}
+
+bool ArgsInitializer::IsFrozen() const
+{
+	return frozen_;
+}
+
+ArgsInitializer& ArgsInitializer::SetConfigFile(std::string_view path)
+{
+	config_file_ = path;
+	RefreshExternalValues();
+	return *this;
+}
+
+std::string_view ArgsInitializer::GetConfigFile() const
+{
+	return config_file_;
+}
+
+std::shared_ptr<const ArgsExternalValues> ArgsInitializer::GetExternalValues(std::pmr::memory_resource* resource) const
+{
+	if (external_values_ == nullptr)
+	{
+		return ReadExternalValues(resource);
+	}
+	std::lock_guard<std::mutex> lock(external_values_->mutex);
+	if (external_values_->values == nullptr)
+	{
+		external_values_->values = ReadExternalValues(resource_);
+	}
+	return external_values_->values;
+}
+
+void ArgsInitializer::RefreshExternalValues()
+{
+	if (external_values_ != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(external_values_->mutex);
+		external_values_->values = nullptr;
+	}
+}
+
+std::shared_ptr<const ArgsExternalValues> ArgsInitializer::ReadExternalValues(std::pmr::memory_resource* resource) const
+{
+	auto values = std::allocate_shared<ArgsExternalValues>(
+		std::pmr::polymorphic_allocator<ArgsExternalValues>(resource),
+		GetArgsCount(),
+		resource);
+	values->Read(*this);
+	return values;
+}
+
+bool ArgsInitializer::HasEnvOptions() const
+{
+	return !env_name_to_index_.empty();
+}
+
+bool ArgsInitializer::HasConfigOptions() const
+{
+	return !config_key_to_index_.empty();
+}
+
+size_t ArgsInitializer::FindEnvOption(std::string_view name) const
+{
+	if (frozen_)
+	{
+		return env_table_.Find(name);
+	}
+	const auto it = env_name_to_index_.find(name);
+	return it == env_name_to_index_.cend() ? ArgsLookupTable::npos : it->second;
+}
+
+size_t ArgsInitializer::FindConfigOption(std::string_view key) const
+{
+	if (frozen_)
+	{
+		return config_table_.Find(key);
+	}
+	const auto it = config_key_to_index_.find(key);
+	return it == config_key_to_index_.cend() ? ArgsLookupTable::npos : it->second;
+}
+
+ArgsInitializer& ArgsInitializer::EnableResponseFiles(bool enable)
+{
+	response_files_enabled_ = enable;
+	return *this;
+}
+
+bool ArgsInitializer::IsResponseFilesEnabled() const
+{
+	return response_files_enabled_;
+}
+
+const ArgInfos& ArgsInitializer::GetArgInfos(std::string_view value) const
 {
 	if (value.empty())
 	{
 		throw ArgsParserException("Unknown empty param.");
 	}
-	if (value.size() == 2 || value[1] != '-')
+	const auto* arg_info = FindArgInfos(value);
+	if (arg_info == nullptr)
+	{
+		throw ArgsParserException("Unknown param: " + std::string(value) + ".");
+	}
+	return *arg_info;
+}
+
+const ArgInfos* ArgsInitializer::FindArgInfos(std::string_view value) const
+{
+	if (frozen_)
+	{
+		const auto index = lookup_table_.Find(value);
+		return index == ArgsLookupTable::npos ? nullptr : indexed_args_infos_[index];
+	}
+
+	auto full_name_it = args_infos_.end();
+	if (value.size() == 2 || (value.size() > 1 && value[1] != '-'))
 	{
 		const auto it = short_to_full_name_.find(value);
 		if (it == short_to_full_name_.cend())
 		{
-			throw ArgsParserException("Unknown param: " + std::string(value) + ".");
+			return nullptr;
 		}
-		value = it->second;
+		full_name_it = args_infos_.find(it->second);
 	}
-	const auto it = args_infos_.find(value);
-	if (it == args_infos_.cend())
+	else
 	{
-		throw ArgsParserException("Unknown param: " + std::string(value) + ".");
+		full_name_it = args_infos_.find(value);
+	}
+	return full_name_it == args_infos_.cend() ? nullptr : &full_name_it->second;
+}
+
+ArgsInitializer& ArgsInitializer::SetConversion(ArgsConversion conversion)
+{
+	conversion_ = conversion;
+	return *this;
+}
+
+ArgsConversion ArgsInitializer::GetConversion() const
+{
+	return conversion_;
+}
+
+ArgsInitializer& ArgsInitializer::AddExclusiveGroup(const std::vector<std::string_view>& names)
+{
+	AddGroup(GroupType::Exclusive, {}, names);
+	return *this;
+}
+
+ArgsInitializer& ArgsInitializer::AddAtLeastOneGroup(const std::vector<std::string_view>& names)
+{
+	AddGroup(GroupType::AtLeastOne, {}, names);
+	return *this;
+}
+
+ArgsInitializer& ArgsInitializer::AddRequires(std::string_view name, const std::vector<std::string_view>& required_names)
+{
+	AddGroup(GroupType::Requires, name, required_names);
+	return *this;
+}
+
+ArgsParseError ArgsInitializer::CheckGroups(const ArgsBitset& set_options) const
+{
+	for (const auto& group : groups_)
+	{
+		size_t set_count = 0;
+		bool all_set = true;
+		for (const auto& [index, word] : group.words)
+		{
+			const auto set_word = word & set_options.GetWord(index);
+			set_count += static_cast<size_t>(__builtin_popcountll(set_word));
+			all_set = all_set && set_word == word;
+		}
+
+		auto code = ArgsErrorCode::None;
+		switch (group.type)
+		{
+		case GroupType::Exclusive:
+			code = set_count > 1 ? ArgsErrorCode::ConflictingParams : code;
+			break;
+		case GroupType::AtLeastOne:
+			code = set_count == 0 ? ArgsErrorCode::GroupParamNotSet : code;
+			break;
+		case GroupType::Requires:
+			code = !all_set && group.option_index < set_options.Size() && set_options.Test(group.option_index)
+				? ArgsErrorCode::DependentParamNotSet
+				: code;
+			break;
+		}
+		if (code == ArgsErrorCode::None)
+		{
+			continue;
+		}
+
+		// Params of the error: set options of exclusive group, all options of
+		// at-least-one group, the dependent option and missing ones of requires.
+		std::vector<size_t> params;
+		const auto add_param = [&params](size_t index)
+		{
+			params.push_back(index);
+			return true;
+		};
+		if (code == ArgsErrorCode::DependentParamNotSet)
+		{
+			add_param(group.option_index);
+		}
+		for (const auto& [index, word] : group.words)
+		{
+			const auto set_word = set_options.GetWord(index);
+			const auto params_word = code == ArgsErrorCode::ConflictingParams
+				? word & set_word
+				: (code == ArgsErrorCode::GroupParamNotSet ? word : word & ~set_word);
+			ArgsBitset::ForEachInWord(index, params_word, add_param);
+		}
+		ArgsParseError error(code);
+		error.SetParams(std::move(params), this, &GetOptionFullName);
+		return error;
 	}
-	return it->second;
+	return ArgsParseError();
 }
 
-const std::map<std::string, ArgInfos>& ArgsInitializer::GetArgsInfos() const
+void ArgsInitializer::AddGroup(GroupType type, std::string_view name, const std::vector<std::string_view>& names)
+{
+	if (frozen_)
+	{
+		throw ArgsInitializerException("Can't add group to frozen args initializer.");
+	}
+	const auto find_index = [this](std::string_view option_name)
+	{
+		const auto* arg_info = FindArgInfos(option_name);
+		if (arg_info == nullptr)
+		{
+			throw ArgsInitializerException("Unknown option in group " + std::string(option_name) + ".");
+		}
+		return arg_info->GetIndex();
+	};
+
+	ArgsBitset options(GetArgsCount());
+	for (const auto option_name : names)
+	{
+		options.Set(find_index(option_name));
+	}
+	const auto min_count = type == GroupType::Exclusive ? 2u : 1u;
+	if (options.Count() < min_count)
+	{
+		throw ArgsInitializerException("Too few options in group.");
+	}
+
+	OptionsGroup group{ type, std::pmr::vector<std::pair<size_t, uint64_t>>(resource_) };
+	if (type == GroupType::Requires)
+	{
+		group.option_index = find_index(name);
+		if (options.Test(group.option_index))
+		{
+			throw ArgsInitializerException("Option can't require itself " + std::string(name) + ".");
+		}
+	}
+	for (size_t i = 0; i < options.GetWordsCount(); ++i)
+	{
+		if (options.GetWord(i) != 0)
+		{
+			group.words.emplace_back(i, options.GetWord(i));
+		}
+	}
+	groups_.push_back(std::move(group));
+}
+
+ArgsInitializer& ArgsInitializer::EnableAbbreviations(bool enable)
+{
+	abbreviations_enabled_ = enable;
+	return *this;
+}
+
+bool ArgsInitializer::IsAbbreviationsEnabled() const
+{
+	return abbreviations_enabled_;
+}
+
+const ArgInfos* ArgsInitializer::FindArgInfosByPrefix(std::string_view prefix, bool& ambiguous) const
+{
+	ambiguous = false;
+	if (prefix.size() <= 2 || !StartsWith(prefix, "--"))
+	{
+		return nullptr;
+	}
+
+	if (frozen_)
+	{
+		const auto index = name_trie_.FindByPrefix(prefix);
+		ambiguous = index == ArgsNameTrie::ambiguous;
+		return index == ArgsNameTrie::npos || ambiguous ? nullptr : indexed_args_infos_[index];
+	}
+
+	// Full names are sorted, so names with the prefix are adjacent.
+	const auto it = args_infos_.lower_bound(prefix);
+	if (it == args_infos_.cend() || !StartsWith(it->first, prefix))
+	{
+		return nullptr;
+	}
+	const auto next = std::next(it);
+	ambiguous = next != args_infos_.cend() && StartsWith(next->first, prefix);
+	return ambiguous ? nullptr : &it->second;
+}
+
+std::vector<std::string_view> ArgsInitializer::FindNamesByPrefix(std::string_view prefix, size_t max_count) const
+{
+	if (frozen_)
+	{
+		return name_trie_.CollectByPrefix(prefix, max_count);
+	}
+
+	std::vector<std::string_view> result;
+	for (auto it = args_infos_.lower_bound(prefix);
+		it != args_infos_.cend() && result.size() < max_count && StartsWith(it->first, prefix);
+		++it)
+	{
+		result.push_back(it->first);
+	}
+	return result;
+}
+
+std::vector<std::string_view> ArgsInitializer::FindSimilarNames(std::string_view name, size_t max_count) const
+{
+	const auto max_distance = GetMaxSuggestionDistance(name);
+	if (frozen_)
+	{
+		return name_trie_.FindSimilar(name, max_distance, max_count);
+	}
+
+	std::vector<std::pair<size_t, std::string_view>> candidates;
+	const auto add_candidate = [&candidates, name, max_distance](std::string_view candidate)
+	{
+		const auto distance = GetEditDistance(name, candidate);
+		if (distance <= max_distance)
+		{
+			candidates.emplace_back(distance, candidate);
+		}
+	};
+	for (const auto& [full_name, arg_info] : args_infos_)
+	{
+		add_candidate(full_name);
+		if (!arg_info.GetShortName().empty())
+		{
+			add_candidate(arg_info.GetShortName());
+		}
+	}
+	std::sort(candidates.begin(), candidates.end());
+
+	std::vector<std::string_view> result;
+	for (size_t i = 0; i < candidates.size() && i < max_count; ++i)
+	{
+		result.push_back(candidates[i].second);
+	}
+	return result;
+}
+
+const ArgInfos& ArgsInitializer::GetArgInfosByIndex(size_t index) const
+{
+	if (index >= indexed_args_infos_.size())
+	{
+		throw ArgsParserException("Incorrect option index.");
+	}
+	return *indexed_args_infos_[index];
+}
+
+size_t ArgsInitializer::GetArgsCount() const
+{
+	return indexed_args_infos_.size();
+}
+
+const ArgsInfosMap& ArgsInitializer::GetArgsInfos() const
 {
 	return args_infos_;
 }
 
-const std::string& ArgsInitializer::GetDescription() const
+std::string_view ArgsInitializer::GetDescription() const
 {
 	return description_;
 }
@@ -226,147 +838,507 @@ size_t ArgsInitializer::GetMaxSizeArgHelpInfo() const
 	return max_size_arg_help_info_;
 }
 
+const ArgsHelpLayout& ArgsInitializer::GetHelpLayout() const
+{
+	return help_layout_;
+}
+
+const ArgsValueStore& ArgsInitializer::GetDefaults() const
+{
+	return defaults_;
+}
+
+const ArgsBitset& ArgsInitializer::GetRequiredOptions() const
+{
+	return required_options_;
+}
+
+const ArgsBitset& ArgsInitializer::GetExternalOptions() const
+{
+	return external_options_;
+}
+
+const ArgsBitset& ArgsInitializer::GetBoundOptions() const
+{
+	return bound_options_;
+}
+
+const std::type_info* ArgsInitializer::GetBoundObjectType() const
+{
+	return bound_object_type_;
+}
+
+std::pmr::memory_resource* ArgsInitializer::GetMemoryResource() const
+{
+	return resource_;
+}
+
 void ArgsInitializer::AddArg(
 	std::string option_name,
 	std::string help,
-	std::unique_ptr<IArgValue> arg_value,
+	ArgValuePtr arg_value,
 	ArgOptions arg_options)
 {
-	auto [full_name, short_name] = SplitOptionName(option_name);
-	if (full_name == "--help" || short_name == "-h")
+	if (frozen_)
+	{
+		throw ArgsInitializerException("Can't add option to frozen args initializer.");
+	}
+
+	const auto* bound_object_type = arg_value == nullptr ? nullptr : arg_value->GetBoundObjectType();
+	if (bound_object_type != nullptr && bound_object_type_ != nullptr && *bound_object_type != *bound_object_type_)
 	{
-		throw ArgsParserException("--help, -h reserved args.");
+		throw ArgsInitializerException("Option " + option_name + " is bound to a member of another type.");
 	}
-	if (args_infos_.count(full_name) != 0)
+
+	const auto name_parts = SplitOptionName(option_name);
+	const auto full_name = "--" + std::string(name_parts.full_name);
+	const auto short_name = name_parts.short_name.empty() ? std::string() : "-" + std::string(name_parts.short_name);
+	if (args_infos_.count(std::string_view(full_name)) != 0)
 	{
 		throw ArgsParserException("Duplicate full option name " + full_name + ".");
 	}
 
+	if (!arg_options.env_name.empty() && env_name_to_index_.count(std::string_view(arg_options.env_name)) != 0)
+	{
+		throw ArgsParserException("Duplicate environment variable name " + std::string(arg_options.env_name) + ".");
+	}
+	if (!arg_options.config_key.empty() && config_key_to_index_.count(std::string_view(arg_options.config_key)) != 0)
+	{
+		throw ArgsParserException("Duplicate config key " + std::string(arg_options.config_key) + ".");
+	}
+
 	if (!short_name.empty())
 	{
-		if (short_to_full_name_.count(short_name) != 0)
+		if (short_to_full_name_.count(std::string_view(short_name)) != 0)
 		{
 			throw ArgsParserException("Duplicate short option name " + short_name + ".");
 		}
-		short_to_full_name_.emplace(short_name, full_name);
+		short_to_full_name_.emplace(std::string_view(short_name), std::string_view(full_name));
+	}
+
+	const auto index = indexed_args_infos_.size();
+	if (!arg_options.env_name.empty())
+	{
+		env_name_to_index_.emplace(std::string_view(arg_options.env_name), index);
+	}
+	if (!arg_options.config_key.empty())
+	{
+		config_key_to_index_.emplace(std::string_view(arg_options.config_key), index);
 	}
-	args_infos_.emplace(
-		full_name,
+	const auto it = args_infos_.emplace(
+		std::string_view(full_name),
 		ArgInfos(
 			full_name,
-			std::move(help),
+			help,
 			std::move(arg_value),
 			std::move(arg_options),
-			std::move(short_name)));
+			short_name,
+			index,
+			resource_)).first;
+	indexed_args_infos_.push_back(&it->second);
+
+	const auto& arg_info = it->second;
+	defaults_.Resize(indexed_args_infos_.size());
+	if (arg_info.HasValue() && arg_info.GetValue().HasDefaultValue())
+	{
+		arg_info.GetValue().SetDefaultInto(defaults_, index);
+	}
+	required_options_.Resize(indexed_args_infos_.size());
+	if (arg_info.GetOptions().required)
+	{
+		required_options_.Set(index);
+	}
+	external_options_.Resize(indexed_args_infos_.size());
+	if (!arg_info.GetOptions().env_name.empty() || !arg_info.GetOptions().config_key.empty())
+	{
+		external_options_.Set(index);
+	}
+	bound_options_.Resize(indexed_args_infos_.size());
+	if (arg_info.HasValue() && arg_info.GetValue().IsBound())
+	{
+		bound_options_.Set(index);
+	}
+	if (bound_object_type != nullptr)
+	{
+		bound_object_type_ = bound_object_type;
+	}
 }
 
 ArgsContainer::ArgsContainer(
-	std::map<std::string, std::any> args,
-	std::map<std::string, std::string> short_to_full_name)
-	: args_(std::move(args))
-	, short_to_full_name_(std::move(short_to_full_name))
-{}
+	ArgsValueStore values,
+	std::string_view help,
+	const ArgsInitializer& args_initializer,
+	std::string_view program_name,
+	std::pmr::memory_resource* resource)
+	: values_(std::move(values))
+	, help_(help, resource)
+	, args_initializer_(&args_initializer)
+	, defaults_(&args_initializer.GetDefaults())
+	, program_name_(program_name, resource)
+{
+	ResetLazyValues();
+	count_ = CountValues();
+}
 
-bool ArgsContainer::Exist(const std::string& key) const
+// The copy is allocated from the memory resource of other.
+ArgsContainer::ArgsContainer(const ArgsContainer& other)
+	: values_(other.CopyValues())
+	, help_(other.help_, other.help_.get_allocator())
+	, args_initializer_(other.args_initializer_)
+	, defaults_(other.defaults_)
+	, program_name_(other.program_name_, other.program_name_.get_allocator())
+	, count_(other.count_)
 {
-	if (key.size() <= 1)
+	ResetLazyValues();
+}
+
+ArgsContainer& ArgsContainer::operator=(const ArgsContainer& other)
+{
+	if (this != &other)
+	{
+		*this = ArgsContainer(other);
+	}
+	return *this;
+}
+
+bool ArgsContainer::Exist(std::string_view key) const
+{
+	const auto index = ResolveIndex(key);
+	if (index == help_index)
+	{
+		return true;
+	}
+	if (index >= values_.Size())
 	{
 		return false;
 	}
-	if (key.size() == 2 || key[1] != '-')
+	// Pending raw values are set, they may be being converted now.
+	if (lazy_values_ != nullptr && lazy_values_->pending[index].load(std::memory_order_acquire))
 	{
-		const auto it = short_to_full_name_.find(key);
-		if (it == short_to_full_name_.cend())
+		return true;
+	}
+	return values_.Has(index) || (defaults_ != nullptr && index < defaults_->Size() && defaults_->Has(index));
+}
+
+size_t ArgsContainer::Count() const
+{
+	return count_;
+}
+
+std::string ArgsContainer::GetHelp() const
+{
+	// Help is stored only if it was requested on the command line.
+	return help_.empty() ? GetHelpString(program_name_, *args_initializer_) : std::string(help_);
+}
+
+void ArgsContainer::WriteHelp(std::ostream& stream) const
+{
+	if (help_.empty())
+	{
+		SimpleArgsParser::WriteHelp(stream, program_name_, *args_initializer_);
+		return;
+	}
+	stream.write(help_.data(), static_cast<std::streamsize>(help_.size()));
+}
+
+size_t ArgsContainer::ResolveIndex(std::string_view key) const
+{
+	if (key == help_full_name || key == help_short_name)
+	{
+		return help_index;
+	}
+	const auto* arg_info = args_initializer_->FindArgInfos(key);
+	return arg_info == nullptr ? ArgsLookupTable::npos : arg_info->GetIndex();
+}
+
+void ArgsContainer::ThrowValueError(ValueStatus status, std::string_view key, size_t index) const
+{
+	switch (status)
+	{
+	case ValueStatus::IncorrectValue:
+	{
+		// Conversion is repeated to get the message, the value is kept raw.
+		std::lock_guard<std::mutex> lock(lazy_values_->mutex);
+		std::string_view value;
+		values_.GetRaw(index, value);
+		ArgsValueStore store(index + 1);
+		std::string error;
+		const auto convert_status = args_initializer_->GetArgInfosByIndex(index).GetValue().ParseInto(
+			value,
+			store,
+			index,
+			error);
+		throw ArgsParserException(MakeValueError(convert_status, ArgsParseError::npos, value, std::move(error)).GetMessage());
+	}
+	case ValueStatus::UnknownKey:
+		if (key.empty())
+		{
+			throw ArgsParserException("Incorrect option handle.");
+		}
+		throw ArgsParserException("Value with key " + std::string(key) + " not set.");
+	case ValueStatus::NotSet:
+		throw ArgsParserException("Value not set.");
+	default:
+		// Keep the message of std::any based storage used before.
+		throw ArgsParserException(std::bad_any_cast().what());
+	}
+}
+
+bool ArgsContainer::ConvertRawValue(size_t index) const
+{
+	auto& pending = lazy_values_->pending[index];
+	if (!pending.load(std::memory_order_acquire))
+	{
+		return true;
+	}
+
+	std::lock_guard<std::mutex> lock(lazy_values_->mutex);
+	if (!pending.load(std::memory_order_relaxed))
+	{
+		return true;
+	}
+	std::string_view value;
+	if (values_.GetRaw(index, value))
+	{
+		std::string error;
+		const auto& arg_value = args_initializer_->GetArgInfosByIndex(index).GetValue();
+		if (arg_value.ParseInto(value, values_, index, error) != ConvertStatus::Ok)
 		{
 			return false;
 		}
-		return args_.count(it->second) != 0;
 	}
-	return args_.count(key) != 0;
+	pending.store(false, std::memory_order_release);
+	return true;
 }
 
-size_t ArgsContainer::Count() const
+void ArgsContainer::ResetLazyValues()
 {
-	return args_.size();
+	if (args_initializer_->GetConversion() == ArgsConversion::Eager)
+	{
+		lazy_values_.reset();
+		return;
+	}
+	const auto size = values_.Size();
+	if (lazy_values_ == nullptr || lazy_values_->size != size)
+	{
+		lazy_values_ = std::make_unique<LazyValues>();
+		lazy_values_->pending = std::make_unique<std::atomic<bool>[]>(size);
+		lazy_values_->size = size;
+	}
+	std::string_view value;
+	for (size_t i = 0; i < size; ++i)
+	{
+		lazy_values_->pending[i].store(values_.GetRaw(i, value), std::memory_order_relaxed);
+	}
+}
+
+ArgsValueStore ArgsContainer::CopyValues() const
+{
+	if (lazy_values_ == nullptr)
+	{
+		return values_;
+	}
+	std::lock_guard<std::mutex> lock(lazy_values_->mutex);
+	return values_;
+}
+
+size_t ArgsContainer::CountValues() const
+{
+	// Help counts as a value.
+	if (defaults_ == nullptr)
+	{
+		return values_.Count() + 1;
+	}
+	return values_.GetFilled().CountOr(defaults_->GetFilled()) + 1;
+}
+
+ArgsParseResult::ArgsParseResult(ArgsContainer args)
+	: args_(std::move(args))
+{}
+
+ArgsParseResult::ArgsParseResult(ArgsParseError error)
+	: error_(std::move(error))
+{}
+
+bool ArgsParseResult::HasValue() const
+{
+	return args_.has_value();
+}
+
+ArgsParseResult::operator bool() const
+{
+	return HasValue();
+}
+
+const ArgsContainer& ArgsParseResult::GetValue() const&
+{
+	if (!args_)
+	{
+		throw ArgsParserException(error_.GetMessage());
+	}
+	return *args_;
+}
+
+ArgsContainer&& ArgsParseResult::GetValue() &&
+{
+	if (!args_)
+	{
+		throw ArgsParserException(error_.GetMessage());
+	}
+	return std::move(*args_);
+}
+
+const ArgsParseError& ArgsParseResult::GetError() const
+{
+	return error_;
+}
+
+ArgsParseResult TryParseArgs(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	std::pmr::memory_resource* resource)
+{
+	ArgsValueStore filled_options(argument_initializer.GetArgsCount(), resource);
+	std::string help;
+	auto error = ParseArgv(argc, argv, argument_initializer, filled_options, help, resource);
+	if (error.GetCode() != ArgsErrorCode::None)
+	{
+		return error;
+	}
+	return ArgsContainer(std::move(filled_options), help, argument_initializer, argv[0], resource);
 }
 
 ArgsContainer ParseArgs(
 	const int argc,
 	const char* const* argv,
-	const ArgsInitializer& argument_initializer)
+	const ArgsInitializer& argument_initializer,
+	std::pmr::memory_resource* resource)
+{
+	return TryParseArgs(argc, argv, argument_initializer, resource).GetValue();
+}
+
+ArgsParseResult TryParseArgsPrefix(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	size_t& positional_index,
+	std::pmr::memory_resource* resource)
 {
+	positional_index = 0;
 	if (argc <= 0)
 	{
-		throw ArgsParserException("Incorrect value of argc param.");
+		return ArgsParseError(ArgsErrorCode::IncorrectArgc);
 	}
 	if (argv == nullptr)
 	{
-		throw ArgsParserException("Incorrect value of argv param.");
+		return ArgsParseError(ArgsErrorCode::IncorrectArgv);
 	}
 
-	std::map<std::string, std::any> filled_options;
-	std::map<std::string, std::string> short_to_full_name;
-	filled_options.emplace("--help", GetHelpString(argv[0], argument_initializer));
-	short_to_full_name.emplace("-h", "--help");
-	const auto u_argc = static_cast<size_t>(argc);
-	for (size_t i = 1; i < u_argc; ++i)
+	ArgsValueStore filled_options(argument_initializer.GetArgsCount(), resource);
+	std::string help;
+	auto error = ParseTokens(
+		ArgvTokens(static_cast<size_t>(argc), argv),
+		argv[0],
+		argument_initializer,
+		filled_options,
+		help,
+		resource,
+		&positional_index);
+	if (error.GetCode() != ArgsErrorCode::None)
 	{
-		const auto* param = argv[i];
+		return error;
+	}
+	return ArgsContainer(std::move(filled_options), help, argument_initializer, argv[0], resource);
+}
 
-		if (param == nullptr)
-		{
-			throw ArgsParserException("Incorrect value of argv param.");
-		}
+ArgsParseError TryParseArgsInto(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	void* object,
+	const std::type_info& object_type,
+	bool& help_requested,
+	std::pmr::memory_resource* resource)
+{
+	help_requested = false;
+	const auto* bound_object_type = argument_initializer.GetBoundObjectType();
+	if (bound_object_type != nullptr && (object == nullptr || *bound_object_type != object_type))
+	{
+		return ArgsParseError(ArgsErrorCode::BindObjectTypeMismatch);
+	}
 
-		const auto& arg_info = argument_initializer.GetArgInfos(param);
-		const auto& full_option_name = arg_info.GetFullName();
-		if (!arg_info.GetShortName().empty())
-		{
-			short_to_full_name.emplace(arg_info.GetShortName(), full_option_name);
-		}
+	// Slots are allocated only if an option which isn't bound is set.
+	ArgsValueStore filled_options(argument_initializer.GetArgsCount(), resource);
+	filled_options.EnableBinding(object);
+	std::string help;
+	auto error = ParseArgv(argc, argv, argument_initializer, filled_options, help, resource);
+	help_requested = error.GetCode() == ArgsErrorCode::None && !help.empty();
+	return error;
+}
 
-		if (!arg_info.HasValue())
-		{
-			filled_options.emplace(full_option_name, true);
-			continue;
-		}
+ArgsParseError TryParseArgsInto(
+	const int argc,
+	const char* const* argv,
+	const ArgsInitializer& argument_initializer,
+	bool& help_requested,
+	std::pmr::memory_resource* resource)
+{
+	return TryParseArgsInto(argc, argv, argument_initializer, nullptr, typeid(void), help_requested, resource);
+}
 
-		if (i + 1 == u_argc)
-		{
-			throw ArgsParserException("Please set param value: " + std::string(param) + ".");
-		}
-		++i;
+ArgsParseContext::ArgsParseContext(
+	const ArgsInitializer& argument_initializer,
+	std::pmr::memory_resource* resource)
+	: args_(ArgsValueStore(argument_initializer.GetArgsCount(), resource), "", argument_initializer, "", resource)
+	, resource_(resource)
+{
+	args_.defaults_ = nullptr;
+	args_.count_ = 1;
+}
 
-		auto value = arg_info.GetValue().GetFromString(argv[i]);
-		filled_options.emplace(full_option_name, std::move(value));
+ArgsParseError ArgsParseContext::TryParse(const int argc, const char* const* argv)
+{
+	const auto& argument_initializer = *args_.args_initializer_;
+	// Options can still be added to the initializer if it isn't frozen.
+	if (args_.values_.Size() != argument_initializer.GetArgsCount())
+	{
+		args_.values_ = ArgsValueStore(argument_initializer.GetArgsCount(), resource_);
 	}
+	args_.values_.Reset();
+	args_.help_.clear();
+	args_.defaults_ = nullptr;
+	args_.count_ = 1;
 
-	for (const auto& [key, value] : argument_initializer.GetArgsInfos())
+	std::string help;
+	auto error = ParseArgv(argc, argv, argument_initializer, args_.values_, help, resource_);
+	if (error.GetCode() != ArgsErrorCode::None)
 	{
-		if (filled_options.count(key) != 0)
-		{
-			continue;
-		}
-
-		const auto& options = value.GetOptions();
-		if (options.required)
-		{
-			throw ArgsParserException("Please set required param " + key + ".");
-		}
-
-		if (!value.HasValue() || !value.GetValue().HasDefaultValue())
-		{
-			continue;
-		}
-
-		if (!value.GetShortName().empty())
-		{
-			short_to_full_name.emplace(value.GetShortName(), key);
-		}
+		args_.values_.Reset();
+		args_.ResetLazyValues();
+		return error;
+	}
+	args_.help_.assign(help.data(), help.size());
+	args_.program_name_.assign(argv[0]);
+	args_.defaults_ = &argument_initializer.GetDefaults();
+	args_.ResetLazyValues();
+	args_.count_ = args_.CountValues();
+	return error;
+}
 
-		filled_options.emplace(key, value.GetValue().GetDefault());
+const ArgsContainer& ArgsParseContext::Parse(const int argc, const char* const* argv)
+{
+	const auto error = TryParse(argc, argv);
+	if (error.GetCode() != ArgsErrorCode::None)
+	{
+		throw ArgsParserException(error.GetMessage());
 	}
-	return ArgsContainer(std::move(filled_options), std::move(short_to_full_name));
+	return args_;
+}
+
+const ArgsContainer& ArgsParseContext::GetArgs() const
+{
+	return args_;
 }
 
-} // namespace SimpleArgsParser
\ No newline at end of file
+} // namespace SimpleArgsParser
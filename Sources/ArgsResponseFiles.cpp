@@ -0,0 +1,198 @@
+#include "../Headers/ArgsResponseFiles.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SimpleArgsParser
+{
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: data_(std::exchange(other.data_, nullptr))
+	, size_(std::exchange(other.size_, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+	const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat file_stat {};
+	if (::fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode))
+	{
+		::close(fd);
+		return false;
+	}
+
+	const auto size = static_cast<size_t>(file_stat.st_size);
+	if (size == 0)
+	{
+		::close(fd);
+		return true;
+	}
+
+	void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+	::madvise(data, size, MADV_SEQUENTIAL);
+
+	data_ = static_cast<char*>(data);
+	size_ = size;
+	return true;
+}
+
+char* MappedFile::GetData() const
+{
+	return data_;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return size_;
+}
+
+void MappedFile::Close()
+{
+	if (data_ != nullptr)
+	{
+		::munmap(data_, size_);
+		data_ = nullptr;
+		size_ = 0;
+	}
+}
+
+ArgsResponseFiles::ArgsResponseFiles(std::pmr::memory_resource* resource)
+	: files_(resource)
+	, tokens_(resource)
+{}
+
+ArgsParseError ArgsResponseFiles::Expand(size_t argc, const char* const* argv)
+{
+	files_.clear();
+	tokens_.clear();
+	include_stack_.clear();
+	tokens_.reserve(argc);
+
+	for (size_t i = 0; i < argc; ++i)
+	{
+		if (argv[i] == nullptr)
+		{
+			return ArgsParseError(ArgsErrorCode::IncorrectArgv, i);
+		}
+		const std::string_view token = argv[i];
+		// Program name is never expanded.
+		if (i == 0 || !IsResponseFile(token))
+		{
+			tokens_.push_back(token);
+			continue;
+		}
+		if (auto error = ExpandFile(token.substr(1), i); error.GetCode() != ArgsErrorCode::None)
+		{
+			return error;
+		}
+	}
+	return ArgsParseError();
+}
+
+const std::pmr::vector<std::string_view>& ArgsResponseFiles::GetTokens() const
+{
+	return tokens_;
+}
+
+bool ArgsResponseFiles::IsResponseFile(std::string_view token)
+{
+	return token.size() > 1 && token.front() == '@';
+}
+
+ArgsParseError ArgsResponseFiles::ExpandFile(std::string_view path, size_t argv_index)
+{
+	if (include_stack_.size() == max_nesting_depth)
+	{
+		return ArgsParseError(ArgsErrorCode::ResponseFilesTooDeep, argv_index, path);
+	}
+
+	// Included files are searched next to the including one, the canonical
+	// path of which always contains '/'.
+	std::string path_string;
+	if (!include_stack_.empty() && path.front() != '/')
+	{
+		const auto& including_path = include_stack_.back();
+		path_string.assign(including_path, 0, including_path.rfind('/') + 1);
+	}
+	path_string.append(path);
+	char real_path[PATH_MAX];
+	if (::realpath(path_string.c_str(), real_path) == nullptr)
+	{
+		return ArgsParseError(ArgsErrorCode::ResponseFileNotRead, argv_index, path);
+	}
+	if (std::find(include_stack_.cbegin(), include_stack_.cend(), real_path) != include_stack_.cend())
+	{
+		return ArgsParseError(ArgsErrorCode::RecursiveResponseFile, argv_index, path);
+	}
+
+	MappedFile file;
+	if (!file.Open(real_path))
+	{
+		return ArgsParseError(ArgsErrorCode::ResponseFileNotRead, argv_index, path);
+	}
+	char* const begin = file.GetData();
+	char* const end = begin + file.GetSize();
+	// Rough estimate of tokens count, saves reallocations of large files.
+	tokens_.reserve(tokens_.size() + file.GetSize() / 8);
+	// Mapping address doesn't change on move, so tokens stay valid.
+	files_.push_back(std::move(file));
+	include_stack_.emplace_back(real_path);
+
+	ArgsParseError error;
+	const auto tokenized = TokenizeResponseFile(
+		begin,
+		end,
+		[this, argv_index, &error](std::string_view token)
+		{
+			if (!IsResponseFile(token))
+			{
+				tokens_.push_back(token);
+				return true;
+			}
+			error = ExpandFile(token.substr(1), argv_index);
+			return error.GetCode() == ArgsErrorCode::None;
+		});
+	include_stack_.pop_back();
+
+	if (!tokenized)
+	{
+		return ArgsParseError(ArgsErrorCode::IncorrectResponseFile, argv_index, path);
+	}
+	return error;
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,218 @@
+#include "../Headers/ArgsSubcommands.h"
+
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+SubcommandParseResult::SubcommandParseResult(
+	ArgsContainer global_args,
+	std::string_view subcommand,
+	std::optional<ArgsContainer> subcommand_args)
+	: global_args_(std::move(global_args))
+	, subcommand_(subcommand)
+	, subcommand_args_(std::move(subcommand_args))
+{}
+
+SubcommandParseResult::SubcommandParseResult(ArgsParseError error)
+	: error_(std::move(error))
+{}
+
+bool SubcommandParseResult::HasValue() const
+{
+	return global_args_.has_value();
+}
+
+SubcommandParseResult::operator bool() const
+{
+	return HasValue();
+}
+
+const ArgsContainer& SubcommandParseResult::GetGlobalArgs() const
+{
+	if (!global_args_)
+	{
+		throw ArgsParserException(error_.GetMessage());
+	}
+	return *global_args_;
+}
+
+bool SubcommandParseResult::HasSubcommand() const
+{
+	return subcommand_args_.has_value();
+}
+
+std::string_view SubcommandParseResult::GetSubcommand() const
+{
+	return subcommand_;
+}
+
+const ArgsContainer& SubcommandParseResult::GetSubcommandArgs() const
+{
+	if (!global_args_)
+	{
+		throw ArgsParserException(error_.GetMessage());
+	}
+	if (!subcommand_args_)
+	{
+		throw ArgsParserException("Subcommand not set.");
+	}
+	return *subcommand_args_;
+}
+
+const ArgsParseError& SubcommandParseResult::GetError() const
+{
+	return error_;
+}
+
+ArgsSubcommands::ArgsSubcommands(const ArgsInitializer& global_initializer)
+	: global_initializer_(global_initializer)
+{}
+
+ArgsSubcommands& ArgsSubcommands::Add(std::string name, std::string help, SubcommandFactory factory)
+{
+	if (name.empty() || name.front() == '-')
+	{
+		throw ArgsInitializerException("Incorrect subcommand name " + name + ".");
+	}
+	if (!factory)
+	{
+		throw ArgsInitializerException("Empty factory of subcommand " + name + ".");
+	}
+	auto subcommand = std::make_unique<Subcommand>();
+	subcommand->help = std::move(help);
+	subcommand->factory = std::move(factory);
+	if (!subcommands_.emplace(name, std::move(subcommand)).second)
+	{
+		throw ArgsInitializerException("Duplicate subcommand " + name + ".");
+	}
+	return *this;
+}
+
+bool ArgsSubcommands::HasSubcommand(std::string_view name) const
+{
+	return subcommands_.find(name) != subcommands_.end();
+}
+
+const ArgsInitializer& ArgsSubcommands::GetInitializer(std::string_view name) const
+{
+	const auto it = subcommands_.find(name);
+	if (it == subcommands_.end())
+	{
+		throw ArgsParserException("Unknown command: " + std::string(name) + ".");
+	}
+	return Build(*it->second);
+}
+
+bool ArgsSubcommands::IsInitializerBuilt(std::string_view name) const
+{
+	const auto it = subcommands_.find(name);
+	return it != subcommands_.end() && it->second->built.load(std::memory_order_acquire);
+}
+
+SubcommandParseResult ArgsSubcommands::TryParse(
+	const int argc,
+	const char* const* argv,
+	std::pmr::memory_resource* resource) const
+{
+	size_t subcommand_index = 0;
+	auto global_result = TryParseArgsPrefix(argc, argv, global_initializer_, subcommand_index, resource);
+	if (!global_result)
+	{
+		return global_result.GetError();
+	}
+	if (subcommand_index == static_cast<size_t>(argc))
+	{
+		return SubcommandParseResult(std::move(global_result).GetValue());
+	}
+
+	const std::string_view name = argv[subcommand_index];
+	const auto it = subcommands_.find(name);
+	if (it == subcommands_.end())
+	{
+		return ArgsParseError(ArgsErrorCode::UnknownSubcommand, subcommand_index, name);
+	}
+	const auto& initializer = Build(*it->second);
+
+	// The subcommand name is put in place of the program name, so help of
+	// the subcommand shows "program subcommand".
+	std::string command_name(argv[0]);
+	command_name += ' ';
+	command_name.append(name.data(), name.size());
+	std::vector<const char*> subcommand_argv(argv + subcommand_index, argv + argc);
+	subcommand_argv[0] = command_name.c_str();
+
+	auto subcommand_result = TryParseArgs(
+		static_cast<int>(subcommand_argv.size()),
+		subcommand_argv.data(),
+		initializer,
+		resource);
+	if (!subcommand_result)
+	{
+		return subcommand_result.GetError();
+	}
+	return SubcommandParseResult(
+		std::move(global_result).GetValue(),
+		name,
+		std::move(subcommand_result).GetValue());
+}
+
+SubcommandParseResult ArgsSubcommands::Parse(
+	const int argc,
+	const char* const* argv,
+	std::pmr::memory_resource* resource) const
+{
+	auto result = TryParse(argc, argv, resource);
+	if (!result)
+	{
+		throw ArgsParserException(result.GetError().GetMessage());
+	}
+	return result;
+}
+
+std::string ArgsSubcommands::GetHelp(std::string_view program_name) const
+{
+	auto result = GetHelpString(program_name, global_initializer_);
+	result += "Available commands:\n";
+	for (const auto& [name, subcommand] : subcommands_)
+	{
+		ArgHelpRow row;
+		row.full_name = name;
+		row.help = subcommand->help;
+		AppendOptionHelp(
+			result,
+			row,
+			global_initializer_.GetMaxSizeArgHelpDesc(),
+			global_initializer_.GetMaxSizeArgHelpInfo());
+	}
+	return result;
+}
+
+std::string ArgsSubcommands::GetSubcommandHelp(std::string_view program_name, std::string_view name) const
+{
+	const auto& initializer = GetInitializer(name);
+	std::string command_name(program_name);
+	command_name += ' ';
+	command_name.append(name.data(), name.size());
+	return GetHelpString(command_name, initializer);
+}
+
+const ArgsInitializer& ArgsSubcommands::Build(Subcommand& subcommand) const
+{
+	std::call_once(
+		subcommand.build_flag,
+		[this, &subcommand]()
+		{
+			auto initializer = std::make_unique<ArgsInitializer>(
+				subcommand.help,
+				global_initializer_.GetMaxSizeArgHelpDesc(),
+				global_initializer_.GetMaxSizeArgHelpInfo());
+			subcommand.factory(*initializer);
+			initializer->Freeze();
+			subcommand.initializer = std::move(initializer);
+			subcommand.built.store(true, std::memory_order_release);
+		});
+	return *subcommand.initializer;
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,135 @@
+#include "../Headers/ArgsValueStore.h"
+
+namespace SimpleArgsParser
+{
+
+ArgsValueStore::ArgsValueStore(size_t size, std::pmr::memory_resource* resource)
+	: slots_(resource)
+	, filled_(size, resource)
+	, raw_copies_(resource)
+{}
+
+ArgsValueStore::ArgsValueStore(const ArgsValueStore& other)
+	: slots_(other.slots_, other.slots_.get_allocator())
+	, filled_(other.filled_)
+	, raw_copies_(other.raw_copies_, other.raw_copies_.get_allocator())
+	, binding_enabled_(other.binding_enabled_)
+	, bind_object_(other.bind_object_)
+{}
+
+void ArgsValueStore::SetRaw(size_t index, std::string_view value)
+{
+	GetSlot(index).emplace<ArgRawValue>().value = value;
+	MarkFilled(index);
+}
+
+void ArgsValueStore::SetRawCopy(size_t index, std::string_view value)
+{
+	GetSlot(index).emplace<ArgRawValue>().copy = raw_copies_.size();
+	raw_copies_.emplace_back(value);
+	MarkFilled(index);
+}
+
+bool ArgsValueStore::GetRaw(size_t index, std::string_view& value) const
+{
+	const auto* raw = std::get_if<ArgRawValue>(&GetSlot(index));
+	if (!filled_.Test(index) || raw == nullptr)
+	{
+		return false;
+	}
+	value = raw->copy == ArgRawValue::no_copy ? raw->value : std::string_view(raw_copies_[raw->copy]);
+	return true;
+}
+
+bool ArgsValueStore::Has(size_t index) const
+{
+	// Index is checked by GetSlot as in other accessors.
+	GetSlot(index);
+	return filled_.Test(index);
+}
+
+void ArgsValueStore::SetBound(size_t index)
+{
+	// The const accessor checks the index without allocating slots.
+	static_cast<const ArgsValueStore*>(this)->GetSlot(index);
+	MarkFilled(index);
+}
+
+void ArgsValueStore::EnableBinding(void* object)
+{
+	binding_enabled_ = true;
+	bind_object_ = object;
+}
+
+bool ArgsValueStore::IsBindingEnabled() const
+{
+	return binding_enabled_;
+}
+
+void* ArgsValueStore::GetBindObject() const
+{
+	return bind_object_;
+}
+
+size_t ArgsValueStore::Size() const
+{
+	return filled_.Size();
+}
+
+void ArgsValueStore::Resize(size_t size)
+{
+	if (!slots_.empty())
+	{
+		slots_.resize(size);
+	}
+	filled_.Resize(size);
+}
+
+size_t ArgsValueStore::Count() const
+{
+	return filled_.Count();
+}
+
+const ArgsBitset& ArgsValueStore::GetFilled() const
+{
+	return filled_;
+}
+
+void ArgsValueStore::Reset()
+{
+	filled_.Clear();
+	raw_copies_.clear();
+}
+
+void ArgsValueStore::MarkFilled(size_t index)
+{
+	if (!filled_.Test(index))
+	{
+		filled_.Set(index);
+	}
+}
+
+ArgSlot& ArgsValueStore::GetSlot(size_t index)
+{
+	if (index >= Size())
+	{
+		throw ArgsParserException("Incorrect option handle.");
+	}
+	if (slots_.empty())
+	{
+		slots_.resize(Size());
+	}
+	return slots_[index];
+}
+
+const ArgSlot& ArgsValueStore::GetSlot(size_t index) const
+{
+	static const ArgSlot empty_slot;
+	if (index >= Size())
+	{
+		throw ArgsParserException("Incorrect option handle.");
+	}
+	return slots_.empty() ? empty_slot : slots_[index];
+}
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,120 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace SimpleArgsParser
+{
+
+namespace
+{
+
+thread_local bool enabled = false;
+thread_local size_t allocations_count = 0;
+thread_local size_t allocations_bytes = 0;
+
+void* Allocate(size_t size, size_t alignment = 0)
+{
+	if (enabled)
+	{
+		++allocations_count;
+		allocations_bytes += size;
+	}
+	size = size == 0 ? 1 : size;
+	// Memory resources allocate with explicit alignment.
+	auto* ptr = alignment == 0
+		? std::malloc(size)
+		: std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+	if (ptr != nullptr)
+	{
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+} // namespace
+
+AllocationCounter::AllocationCounter()
+	: start_count_(allocations_count)
+	, start_bytes_(allocations_bytes)
+	, prev_enabled_(enabled)
+{
+	enabled = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+	enabled = prev_enabled_;
+}
+
+size_t AllocationCounter::GetCount() const
+{
+	return allocations_count - start_count_;
+}
+
+size_t AllocationCounter::GetBytes() const
+{
+	return allocations_bytes - start_bytes_;
+}
+
+} // namespace SimpleArgsParser
+
+void* operator new(size_t size)
+{
+	return SimpleArgsParser::Allocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return SimpleArgsParser::Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return SimpleArgsParser::Allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return SimpleArgsParser::Allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
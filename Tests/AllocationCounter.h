@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace SimpleArgsParser
+{
+
+// Counts heap allocations made by the current thread during its lifetime.
+class AllocationCounter
+{
+
+public:
+	AllocationCounter();
+	~AllocationCounter();
+
+	AllocationCounter(const AllocationCounter&) = delete;
+	AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+	size_t GetCount() const;
+	size_t GetBytes() const;
+
+private:
+	size_t start_count_;
+	size_t start_bytes_;
+	bool prev_enabled_;
+};
+
+} // namespace SimpleArgsParser
@@ -0,0 +1,84 @@
+#include "AllocationCounter.h"
+
+#include <ArgsParser.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace SimpleArgsParser
+{
+
+TEST(ArgsParserAllocations, TestParseContext)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("threads, j", "Threads", ArgValue<int>().SetDefault(1))
+	                ("ratio", "Ratio", ArgValue<double>())
+	                ("name", "Name", ArgValue<std::string>().SetDefault("default name which doesn't fit into small buffer"))
+	                ("ids", "Ids", ArgValue<std::vector<int>>())
+	                ("verbose, v", "Verbose");
+	args_initializer.Freeze();
+
+	const char* full_argv[] = {
+		"program", "-j", "8", "--ratio=0.5", "-v", "--ids", "1,2,3", "--name", "name which doesn't fit into small buffer" };
+	const char* short_argv[] = { "program", "-j", "2" };
+
+	ArgsParseContext context(args_initializer);
+	// Buffers are allocated by the first parses only.
+	context.Parse(9, full_argv);
+	context.Parse(3, short_argv);
+	AllocationCounter counter;
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ(context.Parse(9, full_argv).Count(), 6u);
+		EXPECT_EQ(context.Parse(3, short_argv).Count(), 3u);
+	}
+	EXPECT_EQ(counter.GetCount(), 0u);
+}
+
+TEST(ArgsParserAllocations, TestSharedDefaults)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("name", "Name", ArgValue<std::string>().SetDefault("default name which doesn't fit into small buffer"))
+	                ("ids", "Ids", ArgValue<std::vector<int>>().SetDefault({ 1, 2 }));
+	for (size_t i = 0; i < 100; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Option", ArgValue<std::string>().SetDefault("default value which doesn't fit into small buffer"));
+	}
+	args_initializer.Freeze();
+
+	const char* argv[] = { "program" };
+	size_t allocations = 0;
+	{
+		AllocationCounter counter;
+		const auto args = ParseArgs(1, argv, args_initializer);
+		allocations = counter.GetCount();
+		EXPECT_EQ(args.Count(), 103u);
+	}
+	// Defaults aren't copied, the container allocates only its value slots.
+	EXPECT_LE(allocations, 2u);
+}
+
+TEST(ArgsParserAllocations, TestParseArgsInto)
+{
+	int threads = 0;
+	bool verbose = false;
+	ArgsInitializer args_initializer;
+	args_initializer("threads, j", "Threads", ArgValue<int>().BindTo(&threads).SetDefault(4))
+	                ("verbose, v", "Verbose", ArgValue<bool>().BindTo(&verbose).SetDefault(false));
+	args_initializer.Freeze();
+
+	const char* argv[] = { "program", "-j", "16", "-v", "true" };
+	bool help_requested = false;
+	size_t allocations = 0;
+	{
+		AllocationCounter counter;
+		EXPECT_EQ(TryParseArgsInto(5, argv, args_initializer, help_requested).GetCode(), ArgsErrorCode::None);
+		allocations = counter.GetCount();
+	}
+	// Only the set bits, value slots aren't allocated.
+	EXPECT_LE(allocations, 1u);
+	EXPECT_EQ(threads, 16);
+}
+
+} // namespace SimpleArgsParser
@@ -1,9 +1,67 @@
+#include <ArgsBatchParser.h>
 #include <ArgsParser.h>
+#include <ArgsResponseFiles.h>
+#include <ArgsStaticSchema.h>
+#include <ArgsSubcommands.h>
+#include <ArgsTokenParser.h>
+#include <TestSchema.h>
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 namespace SimpleArgsParser
 {
 
+struct Point
+{
+	int x = 0;
+	int y = 0;
+};
+
+Point ParseFromString(std::string_view value, const ArgsParserHelpStruct<Point>)
+{
+	const auto pos = value.find(':');
+	if (pos == std::string_view::npos)
+	{
+		throw ArgsParserException("Incorrect point.");
+	}
+	return Point{
+		ParseFromString(value.substr(0, pos), ArgsParserHelpStruct<int>()),
+		ParseFromString(value.substr(pos + 1), ArgsParserHelpStruct<int>()) };
+}
+
+std::string ConvertToString(const Point& value)
+{
+	return std::to_string(value.x) + ":" + std::to_string(value.y);
+}
+
+// Converter reporting errors by standard exceptions.
+struct Level
+{
+	int value = 0;
+};
+
+Level ParseFromString(std::string_view value, const ArgsParserHelpStruct<Level>)
+{
+	return Level{ std::stoi(std::string(value)) };
+}
+
+std::string ConvertToString(const Level& value)
+{
+	return std::to_string(value.value);
+}
+
 TEST(ArgsParser, EmptyArgs)
 {
 	ArgsInitializer args_initializer;
@@ -161,6 +219,231 @@ TEST(ArgsParser, TestSeveralArgs)
 	EXPECT_EQ(args.GetValue<double>("--arg4"), 5.67);
 }
 
+TEST(ArgsParser, TestFrozenInitializer)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<int>().SetDefault(34))
+	                ("arg2", "Arg info2")
+	                ("arg3, a3", "Arg info3", ArgValue<std::string>());
+	args_initializer.Freeze();
+	EXPECT_TRUE(args_initializer.IsFrozen());
+
+	const int argc = 4;
+	const char* argv1 = "program";
+	const char* argv2 = "--arg2";
+	const char* argv3 = "-a3";
+	const char* argv4 = "hello";
+	const char* argv[argc] = { argv1, argv2, argv3, argv4 };
+
+	const auto args = ParseArgs(argc, argv, args_initializer);
+	EXPECT_EQ(args.Count(), 4);
+
+	EXPECT_EQ(args.GetValue<int>("-a1"), 34);
+	EXPECT_TRUE(args.Exist("--arg2"));
+	EXPECT_EQ(args.GetValue<std::string>("-a3"), "hello");
+	EXPECT_EQ(args.GetValue<std::string>("--arg3"), "hello");
+
+	EXPECT_EQ(args_initializer.GetArgInfos("-a3").GetIndex(), 2);
+	EXPECT_EQ(args_initializer.FindArgInfos("--arg"), nullptr);
+	EXPECT_EQ(&args_initializer.GetArgInfosByIndex(0), &args_initializer.GetArgInfos("--arg1"));
+}
+
+TEST(ArgsParser, TestAddArgToFrozenInitializer)
+{
+	try
+	{
+		ArgsInitializer args_initializer;
+		args_initializer("arg1, a1", "Help1");
+		args_initializer.Freeze();
+		args_initializer("arg2", "Help2");
+	}
+	catch (const ArgsInitializerException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Can't add option to frozen args initializer.");
+		return;
+	}
+	FAIL();
+}
+
+TEST(ArgsParser, TestStringViewKeys)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<std::string>())
+	                ("arg2", "Arg info2", ArgValue<uint32_t>());
+
+	const std::string storage = "program --arg1 value1 --arg2 42";
+	std::vector<std::string> tokens;
+	std::istringstream stream(storage);
+	for (std::string token; stream >> token;)
+	{
+		tokens.push_back(token);
+	}
+	std::vector<const char*> argv;
+	for (const auto& token : tokens)
+	{
+		argv.push_back(token.c_str());
+	}
+
+	const auto args = ParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+	const std::string_view keys = "--arg1-a1--arg2";
+	EXPECT_TRUE(args.Exist(keys.substr(0, 6)));
+	EXPECT_EQ(args.GetValue<std::string>(keys.substr(6, 3)), "value1");
+	EXPECT_EQ(args.GetValue<uint32_t>(keys.substr(9)), 42);
+	EXPECT_FALSE(args.Exist(keys.substr(0, 5)));
+}
+
+TEST(ArgsParser, TestArgHandles)
+{
+	ArgHandle<int> arg1;
+	ArgHandle<std::string> arg2;
+	ArgHandle<double> arg3;
+	EXPECT_FALSE(arg1.IsValid());
+
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<int>().SetDefault(34), arg1)
+	                ("flag", "Flag info")
+	                ("arg2, a2", "Arg info2", ArgValue<std::string>(), arg2, ArgOptions().SetRequired())
+	                ("arg3", "Arg info3", ArgValue<double>(), arg3);
+	EXPECT_TRUE(arg1.IsValid());
+	EXPECT_EQ(arg2.GetIndex(), 2);
+
+	const int argc = 3;
+	const char* argv1 = "program";
+	const char* argv2 = "-a2";
+	const char* argv3 = "hello";
+	const char* argv[argc] = { argv1, argv2, argv3 };
+
+	const auto args = ParseArgs(argc, argv, args_initializer);
+	EXPECT_EQ(args[arg1], 34);
+	EXPECT_EQ(args[arg2], "hello");
+	EXPECT_EQ(&args[arg2], &args[arg2]);
+
+	try
+	{
+		args[arg3];
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Value not set.");
+		return;
+	}
+	FAIL();
+}
+
+TEST(ArgsParser, TestInvalidArgHandle)
+{
+	try
+	{
+		ArgsInitializer args_initializer;
+		args_initializer("arg1, a1", "Arg info1", ArgValue<int>().SetDefault(34));
+
+		const int argc = 1;
+		const char* argv1 = "program";
+		const char* argv[argc] = { argv1 };
+
+		const auto args = ParseArgs(argc, argv, args_initializer);
+		args[ArgHandle<int>()];
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Incorrect option handle.");
+		return;
+	}
+	FAIL();
+}
+
+TEST(ArgsParser, TestUserTypeValue)
+{
+	ArgHandle<Point> point;
+	ArgsInitializer args_initializer;
+	args_initializer("point, p", "Point", ArgValue<Point>(), point)
+	                ("origin", "Origin", ArgValue<Point>().SetDefault(Point{ 1, 2 }));
+
+	const int argc = 3;
+	const char* argv1 = "program";
+	const char* argv2 = "-p";
+	const char* argv3 = "3:-4";
+	const char* argv[argc] = { argv1, argv2, argv3 };
+
+	const auto args = ParseArgs(argc, argv, args_initializer);
+	EXPECT_EQ(args[point].x, 3);
+	EXPECT_EQ(args[point].y, -4);
+	EXPECT_EQ(args.GetValue<Point>("--origin").y, 2);
+	EXPECT_THROW(args.GetValue<int>("--origin"), ArgsParserException);
+}
+
+// Wide character types are stored inline and parsed as numbers, as char is.
+static_assert(is_inline_slot_type_v<wchar_t>);
+static_assert(is_inline_slot_type_v<char16_t>);
+static_assert(is_inline_slot_type_v<char32_t>);
+
+TEST(ArgsParser, TestWideCharValues)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("wide", "Wide", ArgValue<wchar_t>())
+	                ("utf16", "UTF-16", ArgValue<char16_t>().SetDefault(u'A'))
+	                ("utf32", "UTF-32", ArgValue<char32_t>());
+
+	const char* argv[] = { "program", "--wide", "65", "--utf32", "128512" };
+	const auto args = ParseArgs(5, argv, args_initializer);
+	EXPECT_EQ(args.GetValue<wchar_t>("--wide"), L'A');
+	EXPECT_EQ(args.GetValue<char16_t>("--utf16"), u'A');
+	EXPECT_EQ(args.GetValue<char32_t>("--utf32"), U'\U0001F600');
+	EXPECT_EQ(ArgValue<char16_t>().SetDefault(u'A').GetStringDefaultValue(), "65");
+
+	const char* out_of_range_argv[] = { "program", "--utf16", "65536" };
+	const auto result = TryParseArgs(3, out_of_range_argv, args_initializer);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::ValueOutOfRange);
+}
+
+TEST(ArgsParser, TestMemoryResource)
+{
+	// Null upstream resource makes any allocation outside of the buffers fail.
+	std::array<std::byte, 16384> initializer_buffer;
+	std::pmr::monotonic_buffer_resource initializer_resource(
+		initializer_buffer.data(),
+		initializer_buffer.size(),
+		std::pmr::null_memory_resource());
+
+	ArgsInitializer args_initializer("Program description which doesn't fit small string.", 40, 40, &initializer_resource);
+	args_initializer("argument1, a1", "Argument info which doesn't fit small string.", ArgValue<int>().SetDefault(34))
+	                ("argument2", "Arg info2")
+	                ("argument3, a3", "Arg info3", ArgValue<double>(), ArgOptions().SetRequired().SetEnv("SIMPLE_ARGS_PARSER_UNSET_ARGUMENT3"));
+	args_initializer.Freeze();
+	EXPECT_EQ(args_initializer.GetMemoryResource(), &initializer_resource);
+	const auto& argument3_options = args_initializer.GetArgsInfos().find("--argument3")->second.GetOptions();
+	EXPECT_EQ(argument3_options.env_name.get_allocator().resource(), &initializer_resource);
+
+	std::array<std::byte, 4096> container_buffer;
+	std::pmr::monotonic_buffer_resource container_resource(
+		container_buffer.data(),
+		container_buffer.size(),
+		std::pmr::null_memory_resource());
+
+	const int argc = 4;
+	const char* argv1 = "program";
+	const char* argv2 = "--argument2";
+	const char* argv3 = "-a3";
+	const char* argv4 = "1.5";
+	const char* argv[argc] = { argv1, argv2, argv3, argv4 };
+
+	const auto args = ParseArgs(argc, argv, args_initializer, &container_resource);
+	EXPECT_EQ(args.Count(), 4);
+	EXPECT_EQ(args.GetValue<int>("-a1"), 34);
+	EXPECT_TRUE(args.Exist("--argument2"));
+	EXPECT_EQ(args.GetValue<double>("--argument3"), 1.5);
+
+	// Copy is allocated from the resource of the source, not the default one.
+	auto* default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+	std::optional<ArgsContainer> args_copy;
+	EXPECT_NO_THROW(args_copy.emplace(args));
+	std::pmr::set_default_resource(default_resource);
+	ASSERT_TRUE(args_copy.has_value());
+	EXPECT_EQ(args_copy->GetValue<double>("--argument3"), 1.5);
+	EXPECT_EQ(args_copy->Count(), 4);
+}
+
 TEST(ArgsParser, TestHelp)
 {
 	ArgsInitializer args_initializer("Program desc.", 15, 20);
@@ -197,6 +480,63 @@ TEST(ArgsParser, TestHelp)
 	EXPECT_EQ(expected_string, args.GetValue<std::string>("--help"));
 }
 
+TEST(ArgsParser, TestHelpOnCommandLine)
+{
+	ArgsInitializer args_initializer("Program desc.");
+	args_initializer("arg, a", "Arg info", ArgValue<int>());
+
+	const int argc = 4;
+	const char* argv1 = "program";
+	const char* argv2 = "-h";
+	const char* argv3 = "-a";
+	const char* argv4 = "5";
+	const char* argv[argc] = { argv1, argv2, argv3, argv4 };
+
+	const std::string expected_string =
+		"Usage: program [options]\n"
+		"Program desc.\n"
+		"Available options:\n"
+		"  --arg,-a arg                          Arg info\n";
+
+	const auto args = ParseArgs(argc, argv, args_initializer);
+	EXPECT_EQ(args.Count(), 2);
+	EXPECT_EQ(args.GetValue<int>("--arg"), 5);
+	EXPECT_EQ(expected_string, args.GetValue<std::string>("--help"));
+	EXPECT_EQ(expected_string, args.GetHelp());
+}
+
+TEST(ArgsParser, TestWriteHelp)
+{
+	ArgsInitializer args_initializer("Program desc.", 15, 20);
+	args_initializer("arg1, a1", "3aaa 4bbbb 9ccccccccc 20dddddddddddddddddddd 6vvvvvv", ArgValue<int>().SetDefault(34))
+		("arg2", "")
+		("arg3", "two  spaces   and   long_word_which_doesnt_fit_into_column end", ArgValue<std::string>())
+		("very_long_option_name, v", "Arg info4", ArgValue<double>().SetDefault(1.5));
+
+	const auto not_frozen_help = GetHelpString("program", args_initializer);
+	EXPECT_TRUE(args_initializer.GetHelpLayout().Empty());
+
+	args_initializer.Freeze();
+	EXPECT_FALSE(args_initializer.GetHelpLayout().Empty());
+	EXPECT_EQ(not_frozen_help, GetHelpString("program", args_initializer));
+
+	std::ostringstream stream;
+	WriteHelp(stream, "program", args_initializer);
+	EXPECT_EQ(not_frozen_help, stream.str());
+
+	std::string buffer = "prefix\n";
+	AppendHelp(buffer, "program", args_initializer);
+	EXPECT_EQ("prefix\n" + not_frozen_help, buffer);
+
+	const int argc = 1;
+	const char* argv1 = "program";
+	const char* argv[argc] = { argv1 };
+	const auto args = ParseArgs(argc, argv, args_initializer);
+	std::ostringstream container_stream;
+	args.WriteHelp(container_stream);
+	EXPECT_EQ(not_frozen_help, container_stream.str());
+}
+
 TEST(ArgsParser, TestDublicateFullNameArg)
 {
 	try
@@ -287,6 +627,26 @@ TEST(ArgsParser, TestEmptyNames)
 	FAIL();
 }
 
+TEST(ArgsParser, TestSpacesInNames)
+{
+	static_assert(SplitOptionName(" port , p ").full_name == "port");
+	static_assert(SplitOptionName(" port , p ").short_name == "p");
+
+	ArgsInitializer args_initializer;
+	args_initializer(" arg1 , a1 ", "Help1");
+	EXPECT_NE(args_initializer.FindArgInfos("-a1"), nullptr);
+	try
+	{
+		args_initializer("arg 2", "Help2");
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Incorrect option name (please remove spaces) arg 2.");
+		return;
+	}
+	FAIL();
+}
+
 TEST(ArgsParser, TestEmptyHelpStringDescSize)
 {
 	try
@@ -353,7 +713,7 @@ TEST(ArgsParser, TestIncorrectArgcValue)
 		args_initializer("arg", "Help info");
 
 		const int argc = 0;
-		const char** argv;
+		const char** argv = nullptr;
 
 		const auto args = ParseArgs(argc, argv, args_initializer);
 	}
@@ -537,7 +897,7 @@ TEST(ArgsParser, TestIncorrectTypeInArgsInitializer)
 	}
 	catch (const ArgsParserException& exc)
 	{
-		EXPECT_STREQ(exc.what(), "stoll");
+		EXPECT_STREQ(exc.what(), "Incorrect value: abs.");
 		return;
 	}
 	FAIL();
@@ -567,4 +927,1187 @@ TEST(ArgsParser, TestOutOfRangeValue)
 	FAIL();
 }
 
-} // namespace SimpleArgsParser
\ No newline at end of file
+TEST(ArgsParser, TestParseFromString)
+{
+	EXPECT_EQ(ParseFromString("-128", ArgsParserHelpStruct<int8_t>()), -128);
+	EXPECT_EQ(ParseFromString("+127", ArgsParserHelpStruct<int8_t>()), 127);
+	EXPECT_EQ(ParseFromString("255", ArgsParserHelpStruct<uint8_t>()), 255);
+	EXPECT_EQ(ParseFromString("18446744073709551615", ArgsParserHelpStruct<uint64_t>()), UINT64_MAX);
+	EXPECT_EQ(ParseFromString("-9223372036854775808", ArgsParserHelpStruct<int64_t>()), INT64_MIN);
+	EXPECT_EQ(ParseFromString("-5.25", ArgsParserHelpStruct<float>()), -5.25f);
+	EXPECT_EQ(ParseFromString("0", ArgsParserHelpStruct<double>()), 0.0);
+	EXPECT_EQ(ParseFromString("0.1", ArgsParserHelpStruct<double>()), 0.1);
+	EXPECT_EQ(ParseFromString("1e-3", ArgsParserHelpStruct<long double>()), 1e-3L);
+	EXPECT_EQ(ParseFromString("true", ArgsParserHelpStruct<bool>()), true);
+	EXPECT_EQ(ParseFromString("0", ArgsParserHelpStruct<bool>()), false);
+}
+
+TEST(ArgsParser, TestParseFromStringErrors)
+{
+	int32_t int_value = 0;
+	EXPECT_EQ(ConvertFromString("12abc", int_value), ConvertStatus::InvalidValue);
+	EXPECT_EQ(ConvertFromString("", int_value), ConvertStatus::InvalidValue);
+	EXPECT_EQ(ConvertFromString("+", int_value), ConvertStatus::InvalidValue);
+	EXPECT_EQ(ConvertFromString("+-1", int_value), ConvertStatus::InvalidValue);
+	EXPECT_EQ(ConvertFromString(" 1", int_value), ConvertStatus::InvalidValue);
+	EXPECT_EQ(ConvertFromString("2147483648", int_value), ConvertStatus::OutOfRange);
+	EXPECT_EQ(int_value, 0);
+
+	uint16_t uint_value = 0;
+	EXPECT_EQ(ConvertFromString("-1", uint_value), ConvertStatus::InvalidValue);
+	EXPECT_EQ(ConvertFromString("65536", uint_value), ConvertStatus::OutOfRange);
+
+	float float_value = 0;
+	EXPECT_EQ(ConvertFromString("1e40", float_value), ConvertStatus::OutOfRange);
+	EXPECT_EQ(ConvertFromString("1.5.", float_value), ConvertStatus::InvalidValue);
+
+	bool bool_value = false;
+	EXPECT_EQ(ConvertFromString("2", bool_value), ConvertStatus::InvalidValue);
+}
+
+TEST(ArgsParser, TestParseArgsBatch)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<int>().SetDefault(34))
+	                ("arg2, a2", "Arg info2", ArgValue<std::string>(), ArgOptions().SetRequired());
+	args_initializer.Freeze();
+
+	const std::vector<std::string> values = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9" };
+	std::vector<std::vector<const char*>> command_lines;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		if (i % 10 == 3)
+		{
+			command_lines.push_back({ "program", "--arg1", "bad" });
+		}
+		else
+		{
+			command_lines.push_back({ "program", "-a2", values[i % 10].c_str(), "-a1", values[i % 7].c_str() });
+		}
+	}
+
+	const auto results = ParseArgsBatch(command_lines, args_initializer, 4);
+	ASSERT_EQ(results.size(), command_lines.size());
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		if (i % 10 == 3)
+		{
+			ASSERT_TRUE(results[i].HasError());
+			EXPECT_EQ(results[i].error.GetCode(), ArgsErrorCode::IncorrectValue);
+			EXPECT_EQ(results[i].error.GetArgvIndex(), 2u);
+			EXPECT_EQ(results[i].error.GetToken(), "bad");
+			EXPECT_EQ(results[i].error.GetMessage(), "Incorrect value: bad.");
+			continue;
+		}
+		ASSERT_FALSE(results[i].HasError());
+		EXPECT_EQ(results[i].args->GetValue<std::string>("--arg2"), values[i % 10]);
+		EXPECT_EQ(results[i].args->GetValue<int>("-a1"), static_cast<int>(i % 7));
+	}
+
+	EXPECT_TRUE(ParseArgsBatch({}, args_initializer).empty());
+}
+
+TEST(ArgsParser, TestConcurrentParseStress)
+{
+	ArgHandle<int> arg1;
+	ArgsInitializer args_initializer("Program desc.");
+	args_initializer("arg1, a1", "Arg info1", ArgValue<int>().SetDefault(34), arg1)
+	                ("arg2, a2", "Arg info2", ArgValue<std::string>().SetDefault("default"))
+	                ("arg3", "Arg info3");
+	args_initializer.Freeze();
+	const auto expected_help = GetHelpString("program", args_initializer);
+
+	const size_t threads_count = 8;
+	std::vector<size_t> failures(threads_count, 0);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threads_count; ++thread)
+	{
+		threads.emplace_back([&, thread]()
+		{
+			for (int i = 0; i < 2000; ++i)
+			{
+				const auto value = std::to_string(i);
+				const char* argv[] = { "program", "--arg1", value.c_str(), "--arg3" };
+				const auto args = ParseArgs(4, argv, args_initializer);
+				if (args[arg1] != i
+					|| args.GetValue<std::string>("-a2") != "default"
+					|| !args.Exist("--arg3")
+					|| (i % 100 == 0 && args.GetHelp() != expected_help))
+				{
+					++failures[thread];
+				}
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	for (const auto thread_failures : failures)
+	{
+		EXPECT_EQ(thread_failures, 0);
+	}
+}
+
+TEST(ArgsParser, TestTryParseArgs)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<uint8_t>())
+	                ("arg2", "Arg info2", ArgValue<int>(), ArgOptions().SetRequired())
+	                ("point", "Point", ArgValue<Point>())
+	                ("level", "Level", ArgValue<Level>())
+	                ("levels", "Levels", ArgValue<std::vector<Level>>());
+
+	const auto check_error = [&](
+		std::vector<const char*> argv,
+		ArgsErrorCode code,
+		size_t argv_index,
+		std::string_view token,
+		const std::string& message)
+	{
+		const auto result = TryParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetCode(), code);
+		EXPECT_EQ(result.GetError().GetArgvIndex(), argv_index);
+		EXPECT_EQ(result.GetError().GetToken(), token);
+		EXPECT_EQ(result.GetError().GetMessage(), message);
+	};
+
+	check_error({ "program", "--arg2", "1", "--arg3" }, ArgsErrorCode::UnknownParam, 3, "--arg3", "Unknown param: --arg3.");
+	check_error({ "program", "--arg2", "1", "" }, ArgsErrorCode::UnknownParam, 3, "", "Unknown empty param.");
+	check_error({ "program", "--arg2" }, ArgsErrorCode::MissingParamValue, 1, "--arg2", "Please set param value: --arg2.");
+	check_error({ "program", "--arg2", "x1" }, ArgsErrorCode::IncorrectValue, 2, "x1", "Incorrect value: x1.");
+	check_error({ "program", "-a1", "256" }, ArgsErrorCode::ValueOutOfRange, 2, "256", "Value out of range.");
+	check_error({ "program", "-a1", "2" }, ArgsErrorCode::RequiredParamNotSet, ArgsParseError::npos, "--arg2", "Please set required param --arg2.");
+	check_error({ "program", "--arg2", "1", "--point", "1" }, ArgsErrorCode::IncorrectValue, 4, "1", "Incorrect point.");
+	check_error({ "program", "--arg2", "1", "--level", "x" }, ArgsErrorCode::IncorrectValue, 4, "x", "stoi");
+	check_error({ "program", "--arg2", "1", "--levels", "1,x" }, ArgsErrorCode::IncorrectValue, 4, "1,x", "stoi");
+
+	const auto result = TryParseArgs(0, nullptr, args_initializer);
+	ASSERT_FALSE(result.HasValue());
+	EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::IncorrectArgc);
+
+	const char* argv[] = { "program", "--arg2", "7" };
+	auto parsed = TryParseArgs(3, argv, args_initializer);
+	ASSERT_TRUE(parsed);
+	EXPECT_EQ(parsed.GetError().GetCode(), ArgsErrorCode::None);
+	const auto args = std::move(parsed).GetValue();
+	EXPECT_EQ(args.GetValue<int>("--arg2"), 7);
+}
+
+TEST(ArgsParser, TestTryGetValue)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<int>().SetDefault(3))
+	                ("arg2", "Arg info2", ArgValue<int>());
+
+	const char* argv[] = { "program" };
+	const auto args = ParseArgs(1, argv, args_initializer);
+
+	int value = 0;
+	EXPECT_TRUE(args.TryGetValue("-a1", value));
+	EXPECT_EQ(value, 3);
+	EXPECT_FALSE(args.TryGetValue("--arg2", value));
+	EXPECT_FALSE(args.TryGetValue("--arg3", value));
+	EXPECT_FALSE(args.TryGetValue("-h", value));
+	EXPECT_EQ(value, 3);
+
+	double double_value = 0;
+	EXPECT_FALSE(args.TryGetValue("--arg1", double_value));
+
+	std::string help;
+	EXPECT_TRUE(args.TryGetValue("--help", help));
+	EXPECT_EQ(help, args.GetHelp());
+}
+
+TEST(ArgsParser, TestResponseFiles)
+{
+	const auto directory = std::filesystem::temp_directory_path();
+	const auto write_file = [&directory](const std::string& name, const std::string& content)
+	{
+		const auto path = (directory / name).string();
+		std::ofstream(path, std::ios::binary) << content;
+		return "@" + path;
+	};
+
+	const auto nested = write_file("simple_args_parser_nested.rsp", "--arg2 'single \\ quoted'\n");
+	const auto main = write_file(
+		"simple_args_parser_main.rsp",
+		"--arg1 \"5\"\n\t" + nested + " --arg3 escaped\\ space --flag --empty \"\" --arg4 \"a\\\"b\"");
+	const auto recursive = write_file("simple_args_parser_recursive.rsp", "--arg1 1 @" + (directory / "simple_args_parser_recursive.rsp").string());
+	const auto unterminated = write_file("simple_args_parser_unterminated.rsp", "--arg2 \"value");
+
+	ArgsInitializer args_initializer;
+	args_initializer("arg1, a1", "Arg info1", ArgValue<int>())
+	                ("arg2", "Arg info2", ArgValue<std::string>())
+	                ("arg3", "Arg info3", ArgValue<std::string>())
+	                ("arg4", "Arg info4", ArgValue<std::string>())
+	                ("flag", "Flag")
+	                ("empty", "Empty", ArgValue<std::string>().SetDefault("default"));
+
+	{
+		const char* argv[] = { "program", main.c_str() };
+		const auto result = TryParseArgs(2, argv, args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::UnknownParam);
+	}
+
+	args_initializer.EnableResponseFiles();
+	{
+		const char* argv[] = { "program", main.c_str() };
+		const auto args = ParseArgs(2, argv, args_initializer);
+		EXPECT_EQ(args.GetValue<int>("--arg1"), 5);
+		EXPECT_EQ(args.GetValue<std::string>("--arg2"), "single \\ quoted");
+		EXPECT_EQ(args.GetValue<std::string>("--arg3"), "escaped space");
+		EXPECT_EQ(args.GetValue<std::string>("--arg4"), "a\"b");
+		EXPECT_TRUE(args.Exist("--flag"));
+		EXPECT_EQ(args.GetValue<std::string>("--empty"), "");
+	}
+
+	const auto check_error = [&](const std::string& file, ArgsErrorCode code, const std::string& message)
+	{
+		const char* argv[] = { "program", "--arg2", "1", file.c_str() };
+		const auto result = TryParseArgs(4, argv, args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetCode(), code);
+		EXPECT_EQ(result.GetError().GetArgvIndex(), 3);
+		EXPECT_EQ(result.GetError().GetMessage(), message);
+	};
+	check_error(recursive, ArgsErrorCode::RecursiveResponseFile, "Recursive response file: " + recursive.substr(1) + ".");
+	check_error(unterminated, ArgsErrorCode::IncorrectResponseFile, "Unterminated quote in response file: " + unterminated.substr(1) + ".");
+	check_error("@/nonexistent/file.rsp", ArgsErrorCode::ResponseFileNotRead, "Can't read response file: /nonexistent/file.rsp.");
+
+	// Included files are searched next to the including one.
+	std::filesystem::create_directories(directory / "simple_args_parser_rsp");
+	write_file("simple_args_parser_rsp/included.rsp", "--arg2 included");
+	const auto including = write_file("simple_args_parser_rsp/including.rsp", "--arg1 7 @included.rsp");
+	{
+		const char* argv[] = { "program", including.c_str() };
+		const auto args = ParseArgs(2, argv, args_initializer);
+		EXPECT_EQ(args.GetValue<int>("--arg1"), 7);
+		EXPECT_EQ(args.GetValue<std::string>("--arg2"), "included");
+	}
+
+	const auto deep_name = [](size_t depth)
+	{
+		return "simple_args_parser_deep" + std::to_string(depth) + ".rsp";
+	};
+	for (size_t depth = 1; depth <= ArgsResponseFiles::max_nesting_depth; ++depth)
+	{
+		write_file(deep_name(depth), "@" + deep_name(depth + 1));
+	}
+	write_file(deep_name(ArgsResponseFiles::max_nesting_depth + 1), "--arg1 1");
+	check_error(
+		"@" + (directory / deep_name(1)).string(),
+		ArgsErrorCode::ResponseFilesTooDeep,
+		"Too deep nesting of response files: " + deep_name(ArgsResponseFiles::max_nesting_depth + 1) + ".");
+	write_file(deep_name(ArgsResponseFiles::max_nesting_depth), "--arg1 1");
+	{
+		const auto deepest = "@" + (directory / deep_name(1)).string();
+		const char* argv[] = { "program", deepest.c_str() };
+		EXPECT_EQ(ParseArgs(2, argv, args_initializer).GetValue<int>("--arg1"), 1);
+	}
+
+	const auto bad_value = write_file("simple_args_parser_bad_value.rsp", "--arg1 bad");
+	try
+	{
+		const char* argv[] = { "program", bad_value.c_str() };
+		ParseArgs(2, argv, args_initializer);
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Incorrect value: bad.");
+		return;
+	}
+	FAIL();
+}
+
+TEST(ArgsParser, TestEnvAndConfigFile)
+{
+	const auto config_path = (std::filesystem::temp_directory_path() / "simple_args_parser_config.ini").string();
+	std::ofstream(config_path, std::ios::binary)
+		<< "# comment\n"
+		<< "arg1 = 1\n"
+		<< "arg2=2\r\n"
+		<< "; comment\n"
+		<< "arg3 = 3\n"
+		<< "unknown = value\n"
+		<< "[section]\n"
+		<< "  arg5 = \"quoted value\"  \n";
+
+	::setenv("SIMPLE_ARGS_PARSER_ARG1", "10", 1);
+	::setenv("SIMPLE_ARGS_PARSER_ARG2", "20", 1);
+	::setenv("SIMPLE_ARGS_PARSER_FLAG", "true", 1);
+	::unsetenv("SIMPLE_ARGS_PARSER_ARG4");
+
+	ArgsInitializer args_initializer;
+	args_initializer("arg1", "Arg info1", ArgValue<int>(), ArgOptions().SetEnv("SIMPLE_ARGS_PARSER_ARG1").SetConfigKey("arg1"))
+	                ("arg2", "Arg info2", ArgValue<int>(), ArgOptions().SetEnv("SIMPLE_ARGS_PARSER_ARG2").SetConfigKey("arg2"))
+	                ("arg3", "Arg info3", ArgValue<int>().SetDefault(0), ArgOptions().SetConfigKey("arg3"))
+	                ("arg4", "Arg info4", ArgValue<int>().SetDefault(4), ArgOptions().SetEnv("SIMPLE_ARGS_PARSER_ARG4"))
+	                ("arg5", "Arg info5", ArgValue<std::string>(), ArgOptions().SetConfigKey("section.arg5").SetRequired())
+	                ("flag", "Flag", ArgOptions().SetEnv("SIMPLE_ARGS_PARSER_FLAG"));
+	args_initializer.SetConfigFile(config_path);
+
+	const auto check = [&]()
+	{
+		const char* argv[] = { "program", "--arg1", "100" };
+		const auto args = ParseArgs(3, argv, args_initializer);
+		EXPECT_EQ(args.GetValue<int>("--arg1"), 100);
+		EXPECT_EQ(args.GetValue<int>("--arg2"), 20);
+		EXPECT_EQ(args.GetValue<int>("--arg3"), 3);
+		EXPECT_EQ(args.GetValue<int>("--arg4"), 4);
+		EXPECT_EQ(args.GetValue<std::string>("--arg5"), "quoted value");
+		EXPECT_TRUE(args.Exist("--flag"));
+	};
+	check();
+	args_initializer.Freeze();
+	check();
+
+	// Frozen initializer keeps the snapshot until refresh.
+	::setenv("SIMPLE_ARGS_PARSER_ARG2", "x", 1);
+	check();
+	args_initializer.RefreshExternalValues();
+	const char* argv[] = { "program" };
+	const auto result = TryParseArgs(1, argv, args_initializer);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::IncorrectValue);
+	EXPECT_EQ(result.GetError().GetArgvIndex(), ArgsParseError::npos);
+	EXPECT_EQ(result.GetError().GetMessage(), "Incorrect value: x.");
+	::unsetenv("SIMPLE_ARGS_PARSER_ARG1");
+	::unsetenv("SIMPLE_ARGS_PARSER_ARG2");
+	::unsetenv("SIMPLE_ARGS_PARSER_FLAG");
+	args_initializer.RefreshExternalValues();
+
+	const auto args = ParseArgs(1, argv, args_initializer);
+	EXPECT_EQ(args.GetValue<int>("--arg1"), 1);
+	EXPECT_EQ(args.GetValue<int>("--arg2"), 2);
+	EXPECT_FALSE(args.Exist("--flag"));
+
+	std::ofstream(config_path, std::ios::binary) << "[section\n";
+	args_initializer.RefreshExternalValues();
+	const auto incorrect = TryParseArgs(1, argv, args_initializer);
+	ASSERT_FALSE(incorrect);
+	EXPECT_EQ(incorrect.GetError().GetCode(), ArgsErrorCode::IncorrectConfigFile);
+	EXPECT_EQ(incorrect.GetError().GetMessage(), "Incorrect line 1 of config file: " + config_path + ".");
+
+	std::filesystem::remove(config_path);
+	args_initializer.RefreshExternalValues();
+	try
+	{
+		ParseArgs(1, argv, args_initializer);
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Please set required param --arg5.");
+		return;
+	}
+	FAIL();
+}
+
+TEST(ArgsParser, TestDuplicateEnvName)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("arg1", "Arg info1", ArgValue<int>(), ArgOptions().SetEnv("ARG"));
+	try
+	{
+		args_initializer("arg2", "Arg info2", ArgValue<int>(), ArgOptions().SetEnv("ARG"));
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Duplicate environment variable name ARG.");
+		return;
+	}
+	FAIL();
+}
+
+TEST(ArgsParser, TestListValues)
+{
+	ArgHandle<std::vector<int>> ids_handle;
+	ArgsInitializer args_initializer;
+	args_initializer("ids", "Ids", ArgValue<std::vector<int>>(), ids_handle)
+	                ("hosts", "Hosts", ArgValue<std::vector<std::string>>().SetDelimiter(';'))
+	                ("points", "Points", ArgValue<std::vector<Point>>())
+	                ("ports", "Ports", ArgValue<std::vector<uint16_t>>().SetDefault({ 80, 443 }))
+	                ("empty", "Empty", ArgValue<std::vector<int>>());
+
+	std::string long_list;
+	std::vector<int> expected_ids = { 1, 2 };
+	for (int i = 0; i < 100; ++i)
+	{
+		long_list += "," + std::to_string(i * 1000);
+		expected_ids.push_back(i * 1000);
+	}
+	long_list.erase(0, 1);
+	expected_ids.push_back(-3);
+
+	const auto ids = "1,2";
+	const auto tail_ids = "-3";
+	const char* argv[] = {
+		"program", "--ids", ids, "--hosts", "a;b,c", "--ids", long_list.c_str(), "--hosts", "", "--ids", tail_ids,
+		"--points", "1:2", "--empty", "" };
+	const auto args = ParseArgs(15, argv, args_initializer);
+
+	EXPECT_EQ(args[ids_handle], expected_ids);
+	EXPECT_EQ(args.GetValue<std::vector<std::string>>("--hosts"), std::vector<std::string>({ "a", "b,c" }));
+	ASSERT_EQ(args.GetValue<std::vector<Point>>("--points").size(), 1);
+	EXPECT_EQ(args.GetValue<std::vector<Point>>("--points")[0].y, 2);
+	EXPECT_EQ(args.GetValue<std::vector<uint16_t>>("--ports"), std::vector<uint16_t>({ 80, 443 }));
+	EXPECT_TRUE(args.GetValue<std::vector<int>>("--empty").empty());
+	EXPECT_NE(args.GetHelp().find("--ports arg(=80,443)"), std::string::npos);
+
+	const auto check_error = [&](const char* value, const std::string& message)
+	{
+		const char* error_argv[] = { "program", "--ids", "1", "--ids", value };
+		const auto result = TryParseArgs(5, error_argv, args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetArgvIndex(), 4);
+		EXPECT_EQ(result.GetError().GetToken(), value);
+		EXPECT_EQ(result.GetError().GetMessage(), message);
+	};
+	check_error("1,2,x,4", "Incorrect value: x.");
+	check_error("1,,2", "Incorrect value: .");
+	check_error("1,2,3,4,5,6,7,8,9,10,11,12,99999999999", "Value out of range.");
+}
+
+TEST(ArgsParser, TestAbbreviations)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("verbose, v", "Verbose")
+	                ("version", "Version")
+	                ("threads", "Threads", ArgValue<int>())
+	                ("thr", "Thr", ArgValue<int>());
+
+	const char* argv[] = { "program", "--verb", "--thread", "8", "--thr", "2" };
+	auto result = TryParseArgs(6, argv, args_initializer);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::UnknownParam);
+
+	args_initializer.EnableAbbreviations();
+	for (const auto frozen : { false, true })
+	{
+		if (frozen)
+		{
+			args_initializer.Freeze();
+		}
+
+		const auto args = ParseArgs(6, argv, args_initializer);
+		EXPECT_TRUE(args.Exist("--verbose"));
+		EXPECT_FALSE(args.Exist("--version"));
+		EXPECT_EQ(args.GetValue<int>("--threads"), 8);
+		EXPECT_EQ(args.GetValue<int>("--thr"), 2);
+
+		const char* ambiguous_argv[] = { "program", "--ver" };
+		result = TryParseArgs(2, ambiguous_argv, args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::AmbiguousParam);
+		EXPECT_EQ(result.GetError().GetMessage(), "Ambiguous param: --ver.");
+		EXPECT_EQ(result.GetError().GetSuggestions(), std::vector<std::string_view>({ "--verbose", "--version" }));
+
+		const char* short_argv[] = { "program", "-" };
+		result = TryParseArgs(2, short_argv, args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::UnknownParam);
+	}
+}
+
+TEST(ArgsParser, TestSuggestions)
+{
+	ArgsInitializer args_initializer;
+	for (int i = 0; i < 1000; ++i)
+	{
+		args_initializer("option" + std::to_string(i) + ", o" + std::to_string(i), "Help");
+	}
+	args_initializer("argument, a", "Argument", ArgValue<int>())
+	                ("arg", "Arg", ArgValue<int>());
+
+	const std::vector<std::string_view> tokens = {
+		"--ar", "--argumnet", "--option12", "--opton12", "-o1", "--optionx", "-x", "--zzzzzzzzzzzz" };
+	std::vector<std::vector<std::string_view>> not_frozen;
+	for (const auto token : tokens)
+	{
+		not_frozen.push_back(args_initializer.FindSimilarNames(token, 5));
+	}
+
+	args_initializer.Freeze();
+	for (size_t i = 0; i < tokens.size(); ++i)
+	{
+		EXPECT_EQ(args_initializer.FindSimilarNames(tokens[i], 5), not_frozen[i]) << tokens[i];
+	}
+	EXPECT_EQ(not_frozen[0], std::vector<std::string_view>({ "--arg" }));
+	EXPECT_EQ(not_frozen[1], std::vector<std::string_view>({ "--argument" }));
+	EXPECT_TRUE(not_frozen.back().empty());
+
+	const char* argv[] = { "program", "--opton12" };
+	const auto result = TryParseArgs(2, argv, args_initializer);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetMessage(), "Unknown param: --opton12.");
+	EXPECT_EQ(result.GetError().GetSuggestions(1), std::vector<std::string_view>({ "--option12" }));
+}
+
+TEST(ArgsParser, TestAttachedValues)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("threads, j", "Threads", ArgValue<int>())
+	                ("name", "Name", ArgValue<std::string>().SetDefault("default"))
+	                ("verbose, v", "Verbose")
+	                ("extract, x", "Extract")
+	                ("file, f", "File", ArgValue<std::string>())
+	                ("ids", "Ids", ArgValue<std::vector<int>>())
+	                ("level, l1", "Level", ArgValue<int>());
+
+	{
+		const char* argv[] = {
+			"program", "--threads=8", "-vxf", "archive.tar", "--name=a=b", "--ids=1,2", "--ids=3", "-l1", "5" };
+		const auto args = ParseArgs(9, argv, args_initializer);
+		EXPECT_EQ(args.GetValue<int>("--threads"), 8);
+		EXPECT_TRUE(args.Exist("--verbose"));
+		EXPECT_TRUE(args.Exist("--extract"));
+		EXPECT_EQ(args.GetValue<std::string>("--file"), "archive.tar");
+		EXPECT_EQ(args.GetValue<std::string>("--name"), "a=b");
+		EXPECT_EQ(args.GetValue<std::vector<int>>("--ids"), std::vector<int>({ 1, 2, 3 }));
+		EXPECT_EQ(args.GetValue<int>("-l1"), 5);
+	}
+	{
+		const char* argv[] = { "program", "-j8", "-vfout", "--name=", "--verbose=false", "--extract=1" };
+		const auto args = ParseArgs(6, argv, args_initializer);
+		EXPECT_EQ(args.GetValue<int>("-j"), 8);
+		EXPECT_EQ(args.GetValue<std::string>("-f"), "out");
+		EXPECT_EQ(args.GetValue<std::string>("--name"), "");
+		EXPECT_TRUE(args.Exist("--verbose"));
+		EXPECT_TRUE(args.Exist("--extract"));
+	}
+
+	const auto check_error = [&](std::vector<const char*> argv, size_t argv_index, std::string_view token, const std::string& message)
+	{
+		const auto result = TryParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetArgvIndex(), argv_index);
+		EXPECT_EQ(result.GetError().GetToken(), token);
+		EXPECT_EQ(result.GetError().GetMessage(), message);
+	};
+	check_error({ "program", "--threads=x" }, 1, "x", "Incorrect value: x.");
+	check_error({ "program", "--thread=1" }, 1, "--thread", "Unknown param: --thread.");
+	check_error({ "program", "-vz" }, 1, "-vz", "Unknown param: -vz.");
+	check_error({ "program", "-vj" }, 1, "-vj", "Please set param value: -vj.");
+	check_error({ "program", "-vj", "y" }, 2, "y", "Incorrect value: y.");
+	check_error({ "program", "--verbose=yes" }, 1, "yes", "Incorrect value: yes.");
+}
+
+struct StaticOptions
+{
+	int port = 0;
+	std::string host;
+	bool verbose = false;
+	double ratio = 0.5;
+	std::vector<int> ids;
+	Point point;
+	std::string output = "a.out";
+};
+
+constexpr auto static_schema = MakeStaticSchema(
+	"Static schema description.",
+	StaticArg<&StaticOptions::port>("port, p", "Port").SetRequired(),
+	StaticArg<&StaticOptions::host>("host", "Host name").SetDefault("localhost"),
+	StaticFlag<&StaticOptions::verbose>("verbose, v", "Verbose output"),
+	StaticArg<&StaticOptions::ratio>("ratio", "Ratio").SetDefault(0.25),
+	StaticArg<&StaticOptions::ids>("ids", "Ids").SetDelimiter(';'),
+	StaticArg<&StaticOptions::point>("point", "Point"),
+	StaticArg<&StaticOptions::output>("output, o", "Output file"));
+
+// Member default of list option is replaced by the values, as in ParseArgs.
+struct StaticListOptions
+{
+	std::vector<int> ids{ 1, 2 };
+};
+
+constexpr auto static_list_schema = MakeStaticSchema(
+	"Static list schema description.",
+	StaticArg<&StaticListOptions::ids>("ids", "Ids"));
+
+// Names are resolved at compile time.
+static_assert(static_schema.Find("--port") == 0);
+static_assert(static_schema.Find("-p") == 0);
+static_assert(static_schema.Find("-v") == 2);
+static_assert(static_schema.Find("--output") == 6);
+static_assert(static_schema.Find("--p") == static_schema.npos);
+static_assert(static_schema.Find("-port") == static_schema.npos);
+static_assert(static_schema.Find("port") == static_schema.npos);
+
+TEST(ArgsParser, TestStaticSchema)
+{
+	{
+		const char* argv[] = {
+			"program", "--port=8080", "-vo", "out.txt", "--ids", "1;2", "--ids=3",
+			"--point", "1:2", "--host", "example", "--host", "ignored" };
+		const auto options = ParseStaticArgs(13, argv, static_schema);
+		EXPECT_EQ(options.port, 8080);
+		EXPECT_EQ(options.host, "example");
+		EXPECT_TRUE(options.verbose);
+		EXPECT_EQ(options.ratio, 0.25);
+		EXPECT_EQ(options.ids, std::vector<int>({ 1, 2, 3 }));
+		EXPECT_EQ(options.point.x, 1);
+		EXPECT_EQ(options.point.y, 2);
+		EXPECT_EQ(options.output, "out.txt");
+	}
+	{
+		const char* argv[] = { "program", "-p", "1", "--verbose=false", "-h" };
+		const auto result = TryParseStaticArgs(5, argv, static_schema);
+		ASSERT_TRUE(result);
+		EXPECT_TRUE(result.IsHelpRequested());
+		EXPECT_EQ(result.GetValue().host, "localhost");
+		EXPECT_FALSE(result.GetValue().verbose);
+		EXPECT_EQ(result.GetValue().output, "a.out");
+	}
+	{
+		const char* argv[] = { "program", "--ids", "3,4", "--ids", "5" };
+		EXPECT_EQ(ParseStaticArgs(5, argv, static_list_schema).ids, std::vector<int>({ 3, 4, 5 }));
+		EXPECT_EQ(ParseStaticArgs(1, argv, static_list_schema).ids, std::vector<int>({ 1, 2 }));
+	}
+
+	const auto check_error = [](std::vector<const char*> argv, const std::string& message)
+	{
+		const auto result = TryParseStaticArgs(static_cast<int>(argv.size()), argv.data(), static_schema);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetMessage(), message);
+	};
+	check_error({ "program" }, "Please set required param --port.");
+	check_error({ "program", "--port", "x" }, "Incorrect value: x.");
+	check_error({ "program", "--prt", "1" }, "Unknown param: --prt.");
+	check_error({ "program", "-p" }, "Please set param value: -p.");
+	check_error({ "program", "-p", "1", "--ids", "1;x" }, "Incorrect value: x.");
+	check_error({ "program", "-p", "1", "--point", "1" }, "Incorrect point.");
+	check_error({ "program", "-p", "99999999999" }, "Value out of range.");
+
+	// Help is the same as help of the initializer with the same options.
+	ArgsInitializer args_initializer("Static schema description.");
+	args_initializer("port, p", "Port", ArgValue<int>(), ArgOptions().SetRequired())
+	                ("host", "Host name", ArgValue<std::string>().SetDefault("localhost"))
+	                ("verbose, v", "Verbose output")
+	                ("ratio", "Ratio", ArgValue<double>().SetDefault(0.25))
+	                ("ids", "Ids", ArgValue<std::vector<int>>())
+	                ("point", "Point", ArgValue<Point>())
+	                ("output, o", "Output file", ArgValue<std::string>());
+	EXPECT_EQ(static_schema.GetHelp("program"), GetHelpString("program", args_initializer));
+
+	EXPECT_THROW(
+		MakeStaticSchema(
+			"",
+			StaticArg<&StaticOptions::port>("port", ""),
+			StaticArg<&StaticOptions::output>("port, o", "")),
+		ArgsParserException);
+	EXPECT_THROW(
+		MakeStaticSchema(
+			"",
+			StaticArg<&StaticOptions::port>("port, p", ""),
+			StaticArg<&StaticOptions::output>("output, p", "")),
+		ArgsParserException);
+	EXPECT_THROW(StaticArg<&StaticOptions::port>("help", ""), ArgsParserException);
+	EXPECT_THROW(StaticArg<&StaticOptions::port>("-port", ""), ArgsParserException);
+}
+
+TEST(ArgsParser, TestGeneratedSchema)
+{
+	using Generated::GeneratedOptions;
+	static_assert(Generated::generated_options_schema.Find("--log-level") == 2);
+	static_assert(Generated::generated_options_schema.Find("-l") == 2);
+
+	const char* argv[] = { "program", "-p", "80", "-v", "--ids", "1;2", "--ratio=0.5" };
+	const auto options = GeneratedOptions::Parse(7, argv);
+	EXPECT_EQ(options.port, 80);
+	EXPECT_EQ(options.host, "local\"host");
+	EXPECT_EQ(options.log_level, 2u);
+	EXPECT_EQ(options.ratio, 0.5);
+	EXPECT_TRUE(options.verbose);
+	EXPECT_EQ(options.ids, std::vector<int>({ 1, 2 }));
+	EXPECT_EQ(options.offset, INT64_MIN);
+
+	const char* no_port_argv[] = { "program" };
+	const auto result = GeneratedOptions::TryParse(1, no_port_argv);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetMessage(), "Please set required param --port.");
+
+	// Pre-rendered help is the same as help of the initializer with the same options.
+	ArgsInitializer args_initializer("Generated \"schema\" description.", 30, 40);
+	args_initializer("port, p", "Port to listen on, it's long enough to be wrapped.", ArgValue<int>(), ArgOptions().SetRequired())
+	                ("host", "Host name", ArgValue<std::string>().SetDefault("local\"host"))
+	                ("log-level, l", "Log level", ArgValue<unsigned>().SetDefault(2))
+	                ("ratio", "Ratio", ArgValue<double>().SetDefault(0.25))
+	                ("verbose, v", "Verbose output")
+	                ("ids", "Ids", ArgValue<std::vector<int>>())
+	                ("offset", "Offset", ArgValue<int64_t>().SetDefault(INT64_MIN));
+	EXPECT_EQ(GeneratedOptions::GetHelp("program"), GetHelpString("program", args_initializer));
+	EXPECT_EQ(GeneratedOptions::GetHelp("program"), Generated::generated_options_schema.GetHelp("program", 30, 40));
+}
+
+TEST(ArgsParser, TestParseContext)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("threads, j", "Threads", ArgValue<int>().SetDefault(1))
+	                ("ratio", "Ratio", ArgValue<double>())
+	                ("name", "Name", ArgValue<std::string>().SetDefault("default name which doesn't fit into small buffer"))
+	                ("ids", "Ids", ArgValue<std::vector<int>>())
+	                ("verbose, v", "Verbose");
+	args_initializer.Freeze();
+
+	const char* full_argv[] = {
+		"program", "-j", "8", "--ratio=0.5", "-v", "--ids", "1,2,3", "--name", "name which doesn't fit into small buffer" };
+	const char* short_argv[] = { "program", "-j", "2" };
+
+	ArgsParseContext context(args_initializer);
+	EXPECT_EQ(context.GetArgs().Count(), 1u);
+	for (int i = 0; i < 3; ++i)
+	{
+		const auto& full_args = context.Parse(9, full_argv);
+		EXPECT_EQ(full_args.GetValue<int>("-j"), 8);
+		EXPECT_EQ(full_args.GetValue<double>("--ratio"), 0.5);
+		EXPECT_TRUE(full_args.Exist("-v"));
+		EXPECT_EQ(full_args.Count(), 6u);
+
+		const auto& short_args = context.Parse(3, short_argv);
+		EXPECT_EQ(short_args.GetValue<int>("-j"), 2);
+		EXPECT_FALSE(short_args.Exist("--ratio"));
+		EXPECT_FALSE(short_args.Exist("-v"));
+		EXPECT_FALSE(short_args.Exist("--ids"));
+		EXPECT_EQ(short_args.Count(), 3u);
+	}
+	EXPECT_EQ(context.GetArgs().GetValue<std::string>("--name"), "default name which doesn't fit into small buffer");
+
+	const auto& args = context.Parse(9, full_argv);
+	EXPECT_EQ(args.GetValue<std::string>("--name"), "name which doesn't fit into small buffer");
+	EXPECT_EQ(args.GetValue<std::vector<int>>("--ids"), std::vector<int>({ 1, 2, 3 }));
+
+	const char* error_argv[] = { "program", "-j", "3", "--unknown" };
+	const auto error = context.TryParse(4, error_argv);
+	EXPECT_EQ(error.GetCode(), ArgsErrorCode::UnknownParam);
+	EXPECT_EQ(context.GetArgs().Count(), 1u);
+	EXPECT_FALSE(context.GetArgs().Exist("-j"));
+	EXPECT_THROW(context.Parse(4, error_argv), ArgsParserException);
+
+	const char* help_argv[] = { "program", "-h" };
+	EXPECT_EQ(context.Parse(2, help_argv).GetHelp(), GetHelpString("program", args_initializer));
+}
+
+TEST(ArgsParser, TestSubcommands)
+{
+	ArgsInitializer global_initializer("Tool.");
+	global_initializer("config, c", "Config file", ArgValue<std::string>().SetDefault("tool.ini"))
+	                  ("verbose, v", "Verbose");
+	global_initializer.Freeze();
+
+	size_t built_count = 0;
+	ArgsSubcommands subcommands(global_initializer);
+	subcommands.Add(
+		"build",
+		"Build targets",
+		[&built_count](ArgsInitializer& args_initializer)
+		{
+			++built_count;
+			args_initializer("jobs, j", "Jobs", ArgValue<int>().SetDefault(1))
+			                ("target", "Target", ArgValue<std::string>(), ArgOptions().SetRequired());
+		});
+	subcommands.Add(
+		"clean",
+		"Remove build files",
+		[&built_count](ArgsInitializer& args_initializer)
+		{
+			++built_count;
+			args_initializer("all, a", "Remove everything");
+		});
+	EXPECT_THROW(subcommands.Add("clean", "", [](ArgsInitializer&) {}), ArgsInitializerException);
+	EXPECT_THROW(subcommands.Add("--clean", "", [](ArgsInitializer&) {}), ArgsInitializerException);
+
+	const auto help = subcommands.GetHelp("tool");
+	EXPECT_NE(help.find("Available commands:"), std::string::npos);
+	EXPECT_NE(help.find("Remove build files"), std::string::npos);
+	EXPECT_EQ(built_count, 0u);
+
+	// Global option value equal to a subcommand name isn't taken as the subcommand.
+	const char* argv[] = { "tool", "-c", "clean", "-v", "build", "-j", "4", "--target", "all" };
+	const auto result = subcommands.Parse(9, argv);
+	EXPECT_EQ(built_count, 1u);
+	EXPECT_TRUE(subcommands.IsInitializerBuilt("build"));
+	EXPECT_FALSE(subcommands.IsInitializerBuilt("clean"));
+	EXPECT_EQ(result.GetGlobalArgs().GetValue<std::string>("-c"), "clean");
+	EXPECT_TRUE(result.GetGlobalArgs().Exist("-v"));
+	EXPECT_EQ(result.GetSubcommand(), "build");
+	EXPECT_EQ(result.GetSubcommandArgs().GetValue<int>("-j"), 4);
+	EXPECT_EQ(result.GetSubcommandArgs().GetValue<std::string>("--target"), "all");
+
+	subcommands.Parse(9, argv);
+	EXPECT_EQ(built_count, 1u);
+
+	const char* no_subcommand_argv[] = { "tool", "-v" };
+	const auto no_subcommand_result = subcommands.Parse(2, no_subcommand_argv);
+	EXPECT_FALSE(no_subcommand_result.HasSubcommand());
+	EXPECT_EQ(no_subcommand_result.GetGlobalArgs().GetValue<std::string>("-c"), "tool.ini");
+	EXPECT_THROW(no_subcommand_result.GetSubcommandArgs(), ArgsParserException);
+
+	const char* help_argv[] = { "tool", "clean", "--help" };
+	const auto help_result = subcommands.Parse(3, help_argv);
+	EXPECT_EQ(help_result.GetSubcommandArgs().GetHelp(), subcommands.GetSubcommandHelp("tool", "clean"));
+	EXPECT_NE(help_result.GetSubcommandArgs().GetHelp().find("Usage: tool clean"), std::string::npos);
+	EXPECT_EQ(built_count, 2u);
+
+	const char* unknown_argv[] = { "tool", "-v", "install" };
+	const auto unknown_result = subcommands.TryParse(3, unknown_argv);
+	EXPECT_FALSE(unknown_result);
+	EXPECT_EQ(unknown_result.GetError().GetCode(), ArgsErrorCode::UnknownSubcommand);
+	EXPECT_EQ(unknown_result.GetError().GetArgvIndex(), 2u);
+	EXPECT_EQ(unknown_result.GetError().GetMessage(), "Unknown command: install.");
+
+	const char* missing_argv[] = { "tool", "build", "-j", "2" };
+	const auto missing_result = subcommands.TryParse(4, missing_argv);
+	EXPECT_FALSE(missing_result);
+	EXPECT_EQ(missing_result.GetError().GetCode(), ArgsErrorCode::RequiredParamNotSet);
+	EXPECT_THROW(subcommands.Parse(4, missing_argv), ArgsParserException);
+	EXPECT_THROW(subcommands.GetInitializer("install"), ArgsParserException);
+}
+
+TEST(ArgsParser, TestLazyConversion)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("port, p", "Port", ArgValue<int>())
+	                ("ratio", "Ratio", ArgValue<double>().SetDefault(0.5))
+	                ("name", "Name", ArgValue<std::string>().SetDefault("default name which doesn't fit into small buffer"))
+	                ("ids", "Ids", ArgValue<std::vector<int>>())
+	                ("level", "Level", ArgValue<int>(), ArgOptions().SetEnv("SIMPLE_ARGS_PARSER_LAZY_LEVEL"))
+	                ("verbose, v", "Verbose");
+	args_initializer.SetConversion(ArgsConversion::Lazy).EnableResponseFiles().Freeze();
+
+	const auto response_file = (std::filesystem::temp_directory_path() / "simple_args_parser_lazy.rsp").string();
+	std::ofstream(response_file, std::ios::binary) << "--name response_file_name_which_doesnt_fit";
+	const auto response_arg = "@" + response_file;
+	::setenv("SIMPLE_ARGS_PARSER_LAZY_LEVEL", "3", 1);
+
+	const char* argv[] = { "program", "-p", "80", "--ids", "1,2", "-v", response_arg.c_str() };
+	const auto args = ParseArgs(7, argv, args_initializer);
+	::unsetenv("SIMPLE_ARGS_PARSER_LAZY_LEVEL");
+	EXPECT_EQ(args.Count(), 7u);
+	EXPECT_TRUE(args.Exist("--ratio"));
+	EXPECT_EQ(args.GetValue<int>("--port"), 80);
+	EXPECT_EQ(args.GetValue<double>("--ratio"), 0.5);
+	EXPECT_EQ(args.GetValue<std::string>("--name"), "response_file_name_which_doesnt_fit");
+	EXPECT_EQ(args.GetValue<std::vector<int>>("--ids"), std::vector<int>({ 1, 2 }));
+	EXPECT_EQ(args.GetValue<int>("--level"), 3);
+	EXPECT_TRUE(args.Exist("-v"));
+	EXPECT_THROW(args.GetValue<std::string>("--port"), ArgsParserException);
+
+	// Copies convert their raw values independently.
+	const char* default_argv[] = { "program" };
+	const auto default_args = ParseArgs(1, default_argv, args_initializer);
+	const auto copied_args = default_args;
+	EXPECT_EQ(default_args.GetValue<std::string>("--name"), "default name which doesn't fit into small buffer");
+	EXPECT_EQ(copied_args.GetValue<std::string>("--name"), "default name which doesn't fit into small buffer");
+	EXPECT_FALSE(copied_args.Exist("--port"));
+
+	// The first read converts the value once for all threads.
+	{
+		const char* concurrent_argv[] = { "program", "-p", "8080", "--name", "name which doesn't fit into small buffer" };
+		const auto concurrent_args = ParseArgs(5, concurrent_argv, args_initializer);
+		std::vector<std::thread> threads;
+		std::atomic<size_t> correct_count = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			threads.emplace_back(
+				[&concurrent_args, &correct_count]()
+				{
+					if (concurrent_args.GetValue<int>("-p") == 8080
+						&& concurrent_args.GetValue<std::string>("--name") == "name which doesn't fit into small buffer"
+						&& concurrent_args.GetValue<double>("--ratio") == 0.5)
+					{
+						++correct_count;
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		EXPECT_EQ(correct_count, 4u);
+	}
+
+	// Incorrect value is reported on read.
+	const char* incorrect_argv[] = { "program", "-p", "port" };
+	const auto incorrect_args = ParseArgs(3, incorrect_argv, args_initializer);
+	EXPECT_TRUE(incorrect_args.Exist("-p"));
+	int port = 0;
+	EXPECT_FALSE(incorrect_args.TryGetValue("-p", port));
+	try
+	{
+		incorrect_args.GetValue<int>("-p");
+		FAIL();
+	}
+	catch (const ArgsParserException& exc)
+	{
+		EXPECT_STREQ(exc.what(), "Incorrect value: port.");
+	}
+
+	ArgsParseContext context(args_initializer);
+	EXPECT_EQ(context.Parse(3, argv).GetValue<int>("-p"), 80);
+	EXPECT_EQ(context.Parse(1, default_argv).GetValue<std::string>("--name"), "default name which doesn't fit into small buffer");
+	EXPECT_FALSE(context.GetArgs().Exist("-p"));
+
+	args_initializer.SetConversion(ArgsConversion::Eager);
+	const auto result = TryParseArgs(3, incorrect_argv, args_initializer);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::IncorrectValue);
+}
+
+TEST(ArgsParser, TestSharedDefaults)
+{
+	ArgsInitializer args_initializer;
+	ArgHandle<std::string> name_handle;
+	args_initializer("name", "Name", ArgValue<std::string>().SetDefault("default name which doesn't fit into small buffer"), name_handle)
+	                ("ratio", "Ratio", ArgValue<double>().SetDefault(0.5))
+	                ("ids", "Ids", ArgValue<std::vector<int>>().SetDefault({ 1, 2 }))
+	                ("level", "Level", ArgValue<int>());
+	for (size_t i = 0; i < 100; ++i)
+	{
+		args_initializer("option" + std::to_string(i), "Option", ArgValue<std::string>().SetDefault("default value which doesn't fit into small buffer"));
+	}
+	args_initializer.Freeze();
+
+	const char* argv[] = { "program", "--name", "name" };
+	const char* default_argv[] = { "program" };
+	const auto args = ParseArgs(3, argv, args_initializer);
+	// Defaults aren't copied, containers refer to the initializer.
+	const auto default_args = ParseArgs(1, default_argv, args_initializer);
+	EXPECT_EQ(&default_args[name_handle], &args_initializer.GetDefaults().Get<std::string>(name_handle.GetIndex())[0]);
+	EXPECT_EQ(default_args.Count(), 104u);
+
+	EXPECT_EQ(args[name_handle], "name");
+	EXPECT_EQ(args.GetValue<double>("--ratio"), 0.5);
+	EXPECT_EQ(args.GetValue<std::vector<int>>("--ids"), std::vector<int>({ 1, 2 }));
+	EXPECT_EQ(args.GetValue<std::string>("--option99"), "default value which doesn't fit into small buffer");
+	EXPECT_TRUE(args.Exist("--ratio"));
+	EXPECT_FALSE(args.Exist("--level"));
+	EXPECT_THROW(args.GetValue<int>("--ratio"), ArgsParserException);
+	EXPECT_EQ(args.Count(), 104u);
+}
+
+TEST(ArgsParser, TestMissingRequiredParams)
+{
+	ArgsInitializer args_initializer;
+	for (size_t i = 0; i < 70; ++i)
+	{
+		ArgOptions options;
+		if (i == 3 || i == 65)
+		{
+			options.SetRequired();
+		}
+		if (i == 66)
+		{
+			options.SetEnv("SIMPLE_ARGS_PARSER_MISSING_OPTION66").SetRequired();
+		}
+		args_initializer("option" + std::to_string(i), "Option", ArgValue<int>(), std::move(options));
+	}
+	args_initializer.Freeze();
+	EXPECT_EQ(args_initializer.GetRequiredOptions().Count(), 3u);
+	EXPECT_EQ(args_initializer.GetExternalOptions().Count(), 1u);
+
+	::setenv("SIMPLE_ARGS_PARSER_MISSING_OPTION66", "66", 1);
+	const char* argv[] = { "program", "--option1", "1" };
+	const auto result = TryParseArgs(3, argv, args_initializer);
+	ASSERT_FALSE(result);
+	EXPECT_EQ(result.GetError().GetCode(), ArgsErrorCode::RequiredParamNotSet);
+	EXPECT_EQ(result.GetError().GetToken(), "--option3");
+	EXPECT_EQ(result.GetError().GetParams(), std::vector<std::string>({ "--option3", "--option65" }));
+	EXPECT_EQ(result.GetError().GetParamIndexes(), std::vector<size_t>({
+		args_initializer.GetArgsInfos().find("--option3")->second.GetIndex(),
+		args_initializer.GetArgsInfos().find("--option65")->second.GetIndex() }));
+	EXPECT_EQ(result.GetError().GetMessage(), "Please set required params --option3, --option65.");
+
+	const char* one_missing_argv[] = { "program", "--option3", "3" };
+	const auto one_missing_result = TryParseArgs(3, one_missing_argv, args_initializer);
+	ASSERT_FALSE(one_missing_result);
+	EXPECT_EQ(one_missing_result.GetError().GetMessage(), "Please set required param --option65.");
+
+	const char* full_argv[] = { "program", "--option3", "3", "--option65", "65" };
+	const auto args = ParseArgs(5, full_argv, args_initializer);
+	EXPECT_EQ(args.GetValue<int>("--option66"), 66);
+	EXPECT_EQ(args.Count(), 4u);
+	::unsetenv("SIMPLE_ARGS_PARSER_MISSING_OPTION66");
+
+	const auto error_copy = result.GetError();
+	EXPECT_EQ(error_copy.GetToken(), "--option3");
+}
+
+TEST(ArgsParser, TestOptionGroups)
+{
+	ArgsInitializer args_initializer;
+	args_initializer("input, i", "Input file", ArgValue<std::string>())
+	                ("stdin", "Read stdin")
+	                ("tls-key", "TLS key", ArgValue<std::string>())
+	                ("tls-cert", "TLS certificate", ArgValue<std::string>())
+	                ("tls-ca", "TLS CA", ArgValue<std::string>().SetDefault("ca.pem"))
+	                ("verbose, v", "Verbose");
+	args_initializer.AddExclusiveGroup({ "--input", "--stdin" })
+	                .AddAtLeastOneGroup({ "-i", "--stdin" })
+	                .AddRequires("--tls-key", { "--tls-cert", "--tls-ca" });
+	EXPECT_THROW(args_initializer.AddExclusiveGroup({ "--input", "--unknown" }), ArgsInitializerException);
+	EXPECT_THROW(args_initializer.AddExclusiveGroup({ "--input" }), ArgsInitializerException);
+	EXPECT_THROW(args_initializer.AddRequires("--input", { "-i" }), ArgsInitializerException);
+	args_initializer.Freeze();
+	EXPECT_THROW(args_initializer.AddAtLeastOneGroup({ "--input" }), ArgsInitializerException);
+
+	const auto check_error = [&args_initializer](
+		std::vector<const char*> argv,
+		ArgsErrorCode code,
+		std::vector<std::string> params,
+		std::string_view message)
+	{
+		const auto result = TryParseArgs(static_cast<int>(argv.size()), argv.data(), args_initializer);
+		ASSERT_FALSE(result);
+		EXPECT_EQ(result.GetError().GetCode(), code);
+		EXPECT_EQ(result.GetError().GetParams(), params);
+		EXPECT_EQ(result.GetError().GetMessage(), message);
+	};
+	check_error(
+		{ "program", "--stdin", "-i", "file" },
+		ArgsErrorCode::ConflictingParams,
+		{ "--input", "--stdin" },
+		"Params can't be set together: --input, --stdin.");
+	check_error(
+		{ "program", "-v" },
+		ArgsErrorCode::GroupParamNotSet,
+		{ "--input", "--stdin" },
+		"Please set one of params --input, --stdin.");
+	// Default of --tls-ca doesn't satisfy the dependency.
+	check_error(
+		{ "program", "--stdin", "--tls-key", "key.pem" },
+		ArgsErrorCode::DependentParamNotSet,
+		{ "--tls-key", "--tls-cert", "--tls-ca" },
+		"Param --tls-key requires --tls-cert, --tls-ca.");
+	check_error(
+		{ "program", "--stdin", "--tls-key", "key.pem", "--tls-ca", "ca.pem" },
+		ArgsErrorCode::DependentParamNotSet,
+		{ "--tls-key", "--tls-cert" },
+		"Param --tls-key requires --tls-cert.");
+
+	const char* argv[] = { "program", "-i", "file", "--tls-key", "key.pem", "--tls-cert", "cert.pem", "--tls-ca", "ca.pem" };
+	const auto args = ParseArgs(9, argv, args_initializer);
+	EXPECT_EQ(args.GetValue<std::string>("-i"), "file");
+	const char* cert_argv[] = { "program", "--stdin", "--tls-cert", "cert.pem" };
+	EXPECT_TRUE(TryParseArgs(4, cert_argv, args_initializer));
+}
+
+TEST(ArgsParser, TestBindTo)
+{
+	struct Config
+	{
+		int threads = 0;
+		double ratio = 0;
+		std::string name;
+		std::vector<int> ids;
+	};
+	std::string log;
+	std::vector<std::string> tags = { "old" };
+
+	ArgsInitializer args_initializer;
+	args_initializer("threads, j", "Threads", ArgValue<int>().BindTo(&Config::threads).SetDefault(4))
+	                ("ratio", "Ratio", ArgValue<double>().BindTo(&Config::ratio))
+	                ("name", "Name", ArgValue<std::string>().BindTo(&Config::name).SetDefault("default"))
+	                ("ids", "Ids", ArgValue<std::vector<int>>().BindTo(&Config::ids))
+	                ("log", "Log", ArgValue<std::string>().BindTo(&log).SetDefault("log.txt"))
+	                ("tags", "Tags", ArgValue<std::vector<std::string>>().BindTo(&tags))
+	                ("count", "Not bound", ArgValue<int>())
+	                ("verbose, v", "Verbose");
+	struct Other
+	{
+		int value = 0;
+	};
+	EXPECT_THROW(
+		args_initializer("other", "Other", ArgValue<int>().BindTo(&Other::value)),
+		ArgsInitializerException);
+	args_initializer.Freeze();
+
+	const char* argv[] = {
+		"program", "-j", "8", "--ratio=0.5", "--ids", "1,2", "--ids", "3", "--tags", "a", "--tags", "b,c", "--count", "5", "-v" };
+	Config config;
+	config.ids = { 7 };
+	bool help_requested = true;
+	EXPECT_EQ(TryParseArgsInto(15, argv, args_initializer, config, help_requested).GetCode(), ArgsErrorCode::None);
+	EXPECT_FALSE(help_requested);
+	EXPECT_EQ(config.threads, 8);
+	EXPECT_EQ(config.ratio, 0.5);
+	EXPECT_EQ(config.name, "default");
+	EXPECT_EQ(config.ids, std::vector<int>({ 1, 2, 3 }));
+	EXPECT_EQ(log, "log.txt");
+	EXPECT_EQ(tags, std::vector<std::string>({ "a", "b", "c" }));
+
+	// Incorrect value doesn't overwrite the variable.
+	const char* error_argv[] = { "program", "-j", "x" };
+	const auto error = TryParseArgsInto(3, error_argv, args_initializer, config, help_requested);
+	EXPECT_EQ(error.GetCode(), ArgsErrorCode::IncorrectValue);
+	EXPECT_EQ(config.threads, 8);
+	const char* ids_error_argv[] = { "program", "--ids", "4,x" };
+	EXPECT_EQ(
+		TryParseArgsInto(3, ids_error_argv, args_initializer, config, help_requested).GetCode(),
+		ArgsErrorCode::IncorrectValue);
+	EXPECT_EQ(config.ids, std::vector<int>({ 1, 2, 3 }));
+	const char* count_error_argv[] = { "program", "--count", "x" };
+	EXPECT_EQ(
+		TryParseArgsInto(3, count_error_argv, args_initializer, config, help_requested).GetCode(),
+		ArgsErrorCode::IncorrectValue);
+	// Options parsed before the error are written, defaults aren't.
+	config.name = "changed";
+	const char* unknown_argv[] = { "program", "-j", "16", "--unknown" };
+	EXPECT_EQ(
+		TryParseArgsInto(4, unknown_argv, args_initializer, config, help_requested).GetCode(),
+		ArgsErrorCode::UnknownParam);
+	EXPECT_EQ(config.threads, 16);
+	EXPECT_EQ(config.name, "changed");
+
+	const char* help_argv[] = { "program", "--help" };
+	EXPECT_EQ(TryParseArgsInto(2, help_argv, args_initializer, config, help_requested).GetCode(), ArgsErrorCode::None);
+	EXPECT_TRUE(help_requested);
+
+	// Bound members need the object.
+	Other other;
+	const auto type_error = TryParseArgsInto(15, argv, args_initializer, other, help_requested);
+	EXPECT_EQ(type_error.GetCode(), ArgsErrorCode::BindObjectTypeMismatch);
+	EXPECT_EQ(type_error.GetMessage(), "Options are bound to members of another type.");
+	EXPECT_EQ(
+		TryParseArgsInto(15, argv, args_initializer, help_requested).GetCode(),
+		ArgsErrorCode::BindObjectTypeMismatch);
+
+	// Containers hold their own values and never write to bound variables.
+	log = "unchanged";
+	const char* container_argv[] = { "program", "-j", "2", "--log", "run.log", "--count", "5" };
+	const char* other_argv[] = { "program", "-j", "3", "--log", "other.log" };
+	const auto args = ParseArgs(7, container_argv, args_initializer);
+	const auto other_args = ParseArgs(5, other_argv, args_initializer);
+	const auto default_args = ParseArgs(1, other_argv, args_initializer);
+	EXPECT_EQ(args.GetValue<int>("-j"), 2);
+	EXPECT_EQ(args.GetValue<std::string>("--log"), "run.log");
+	EXPECT_EQ(args.GetValue<std::string>("--name"), "default");
+	EXPECT_EQ(args.GetValue<int>("--count"), 5);
+	EXPECT_THROW(args.GetValue<int>("--log"), ArgsParserException);
+	EXPECT_EQ(other_args.GetValue<int>("-j"), 3);
+	EXPECT_EQ(other_args.GetValue<std::string>("--log"), "other.log");
+	EXPECT_EQ(default_args.GetValue<int>("-j"), 4);
+	EXPECT_EQ(default_args.GetValue<std::string>("--log"), "log.txt");
+	EXPECT_EQ(log, "unchanged");
+	EXPECT_EQ(tags, std::vector<std::string>({ "a", "b", "c" }));
+
+	// Variables only.
+	ArgsInitializer variables_initializer;
+	int threads = 0;
+	bool verbose = false;
+	variables_initializer("threads, j", "Threads", ArgValue<int>().BindTo(&threads).SetDefault(4))
+	                     ("verbose, v", "Verbose", ArgValue<bool>().BindTo(&verbose).SetDefault(false));
+	variables_initializer.Freeze();
+	const char* variables_argv[] = { "program", "-j", "16", "-v", "true" };
+	EXPECT_EQ(
+		TryParseArgsInto(5, variables_argv, variables_initializer, help_requested).GetCode(),
+		ArgsErrorCode::None);
+	EXPECT_EQ(threads, 16);
+	EXPECT_TRUE(verbose);
+	const char* default_argv[] = { "program" };
+	EXPECT_EQ(TryParseArgsInto(1, default_argv, variables_initializer, help_requested).GetCode(), ArgsErrorCode::None);
+	EXPECT_EQ(threads, 4);
+	EXPECT_FALSE(verbose);
+}
+
+} // namespace SimpleArgsParser